@@ -0,0 +1,171 @@
+/**
+ * @file    Arena.cpp
+ * @brief   A pool of reusable memory blocks, one per thread, from which
+ *          Populations take their storage. A solve that finishes returns its
+ *          blocks to the pool of the thread that freed them, and the next
+ *          solve on that thread takes them back without touching the global
+ *          heap, so many small solves in parallel do not contend for the
+ *          allocator. Blocks are grouped by size in powers of two.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#include <cstdlib>
+
+#include "Arena.h"
+
+
+/** Provide the pool belonging to the calling thread.
+ * @pre None.
+ * @post The pool exists; it is destroyed when the thread exits.
+ * @return The calling thread's pool.
+ */
+ArenaPool& ArenaPool::local(void)
+{
+    static thread_local ArenaPool pool;
+
+    return pool;
+} // end local()
+
+/** Default constructor. Only local() creates pools.
+ */
+ArenaPool::ArenaPool()
+{
+    for (int i = 0; i < CLASSES; ++i)
+    {
+        spare[i] = NULL;
+        count[i] = 0;
+    } // end for (int i = 0; i < CLASSES; ++i)
+
+    figures.inUse = 0;
+    figures.peak = 0;
+    figures.retained = 0;
+    figures.hits = 0;
+    figures.misses = 0;
+} // end default constructor
+
+/** Destructor. Returns every retained block to the global heap.
+ */
+ArenaPool::~ArenaPool()
+{
+    for (int i = 0; i < CLASSES; ++i)
+    {
+        while (spare[i] != NULL)
+        {
+            Block *next = spare[i]->next;
+
+            std::free(spare[i]);
+            spare[i] = next;
+        } // end while (spare[i] != NULL)
+    } // end for (int i = 0; i < CLASSES; ++i)
+} // end destructor
+
+/** Take a block of at least the given size.
+ * @param bytes  The size wanted.
+ * @pre None.
+ * @post The block is counted as in use.
+ * @return The block; std::bad_alloc is thrown if memory runs out.
+ */
+void *ArenaPool::allocate(size_t bytes)
+{
+    int sizeClass = classOf(bytes);
+    size_t size = sizeClass < CLASSES ? size_t(1) << sizeClass : bytes;
+    void *block;
+
+    if (sizeClass < CLASSES && spare[sizeClass] != NULL)
+    {
+        block = spare[sizeClass];
+        spare[sizeClass] = spare[sizeClass]->next;
+        --count[sizeClass];
+        figures.retained -= size;
+        ++figures.hits;
+    }
+    else
+    {
+        block = std::malloc(size);
+
+        if (block == NULL)
+        {
+            throw std::bad_alloc();
+        } // end if (block == NULL)
+
+        ++figures.misses;
+    } // end if (sizeClass < CLASSES && spare[sizeClass] != NULL)
+
+    figures.inUse += size;
+
+    if (figures.inUse > figures.peak)
+    {
+        figures.peak = figures.inUse;
+    } // end if (figures.inUse > figures.peak)
+
+    return block;
+} // end allocate(size_t)
+
+/** Give back a block from allocate(), on this thread or any other.
+ * @param block  The block.
+ * @param bytes  The size that was asked for when it was taken.
+ * @pre None.
+ * @post The block is kept for reuse, or freed if enough of its size are
+ *       already kept.
+ */
+void ArenaPool::deallocate(void *block, size_t bytes)
+{
+    int sizeClass = classOf(bytes);
+    size_t size = sizeClass < CLASSES ? size_t(1) << sizeClass : bytes;
+
+    if (block == NULL)
+    {
+        return;
+    } // end if (block == NULL)
+
+    // A block taken on another thread is counted there, so in-use figures
+    // here must not go below zero.
+    figures.inUse = figures.inUse > size ? figures.inUse - size : 0;
+
+    if (sizeClass < CLASSES && count[sizeClass] < KEEP)
+    {
+        Block *freed = static_cast<Block*>(block);
+
+        freed->next = spare[sizeClass];
+        spare[sizeClass] = freed;
+        ++count[sizeClass];
+        figures.retained += size;
+    }
+    else
+    {
+        std::free(block);
+    } // end if (sizeClass < CLASSES && count[sizeClass] < KEEP)
+} // end deallocate(void*, size_t)
+
+/** Provide the usage figures for this pool.
+ * @pre None.
+ * @post None.
+ * @return A copy of the current figures.
+ */
+ArenaStats ArenaPool::stats(void) const
+{
+    return figures;
+} // end stats()
+
+/** Find the size class that holds blocks of a given size.
+ * @param bytes  The size wanted.
+ * @pre None.
+ * @post None.
+ * @return The smallest class whose blocks hold bytes, or CLASSES if the
+ *         request is too large to pool.
+ */
+int ArenaPool::classOf(size_t bytes)
+{
+    int sizeClass = 0;
+
+    // Every block must be able to hold the free-list link.
+    while (sizeClass < CLASSES &&
+           ((size_t(1) << sizeClass) < bytes ||
+            (size_t(1) << sizeClass) < sizeof(Block)))
+    {
+        ++sizeClass;
+    } // end while (sizeClass < CLASSES && ...)
+
+    return sizeClass;
+} // end classOf(size_t)
@@ -0,0 +1,158 @@
+/**
+ * @file    Arena.h
+ * @brief   A pool of reusable memory blocks, one per thread, from which
+ *          Populations take their storage. A solve that finishes returns its
+ *          blocks to the pool of the thread that freed them, and the next
+ *          solve on that thread takes them back without touching the global
+ *          heap, so many small solves in parallel do not contend for the
+ *          allocator. Blocks are grouped by size in powers of two.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#ifndef _ARENA_H
+#define	_ARENA_H
+
+#include <cstddef>
+#include <new>
+
+
+/** Usage figures for the pool of one thread.
+ */
+struct ArenaStats
+{
+    size_t inUse;       // bytes currently handed out
+    size_t peak;        // most bytes ever handed out at once
+    size_t retained;    // bytes held in free lists for reuse
+    long hits;          // requests served from a free list
+    long misses;        // requests that went to the global heap
+};
+
+
+class ArenaPool
+{
+public:
+
+    /** Provide the pool belonging to the calling thread.
+     * @pre None.
+     * @post The pool exists; it is destroyed when the thread exits.
+     * @return The calling thread's pool.
+     */
+    static ArenaPool& local(void);
+
+    /** Destructor. Returns every retained block to the global heap.
+     */
+    virtual ~ArenaPool();
+
+    /** Take a block of at least the given size.
+     * @param bytes  The size wanted.
+     * @pre None.
+     * @post The block is counted as in use.
+     * @return The block; std::bad_alloc is thrown if memory runs out.
+     */
+    void *allocate(size_t bytes);
+
+    /** Give back a block from allocate(), on this thread or any other.
+     * @param block  The block.
+     * @param bytes  The size that was asked for when it was taken.
+     * @pre None.
+     * @post The block is kept for reuse, or freed if enough of its size are
+     *       already kept.
+     */
+    void deallocate(void *block, size_t bytes);
+
+    /** Provide the usage figures for this pool.
+     * @pre None.
+     * @post None.
+     * @return A copy of the current figures.
+     */
+    ArenaStats stats(void) const;
+
+private:
+
+    static const int CLASSES = 32;      // size classes, 2^0 to 2^31 bytes
+    static const int KEEP = 8;          // free blocks kept per size class
+
+    /** A free block, linked through its own first bytes.
+     */
+    struct Block
+    {
+        Block *next;
+    };
+
+    Block *spare[CLASSES];
+    int count[CLASSES];
+    ArenaStats figures;
+
+    /** Default constructor. Only local() creates pools.
+     */
+    ArenaPool();
+
+    /** Find the size class that holds blocks of a given size.
+     * @param bytes  The size wanted.
+     * @pre None.
+     * @post None.
+     * @return The smallest class whose blocks hold bytes, or CLASSES if the
+     *         request is too large to pool.
+     */
+    static int classOf(size_t bytes);
+
+    // Not copyable; each thread has exactly one.
+    ArenaPool(const ArenaPool& orig);
+    void operator=(const ArenaPool& rhs);
+
+};
+
+
+/** A standard allocator that draws from the calling thread's ArenaPool.
+ */
+template <class T>
+class ArenaAllocator
+{
+public:
+
+    typedef T value_type;
+
+    /** Default constructor.
+     */
+    ArenaAllocator() {}
+
+    /** Converting constructor, for containers that rebind.
+     * @param orig  The allocator to convert.
+     */
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& orig) {}
+
+    /** Take storage for a number of items.
+     * @param n  The number of items.
+     * @pre None.
+     * @post None.
+     * @return Uninitialized storage for n items.
+     */
+    T *allocate(size_t n)
+    {
+        return static_cast<T*>(ArenaPool::local().allocate(n * sizeof(T)));
+    } // end allocate(size_t)
+
+    /** Give back storage from allocate().
+     * @param p  The storage.
+     * @param n  The number of items it was taken for.
+     * @pre None.
+     * @post None.
+     */
+    void deallocate(T *p, size_t n)
+    {
+        ArenaPool::local().deallocate(p, n * sizeof(T));
+    } // end deallocate(T*, size_t)
+
+    /** All ArenaAllocators are interchangeable.
+     */
+    template <class U>
+    bool operator==(const ArenaAllocator<U>& rhs) const { return true; }
+
+    template <class U>
+    bool operator!=(const ArenaAllocator<U>& rhs) const { return false; }
+
+};
+
+#endif	/* _ARENA_H */
@@ -0,0 +1,340 @@
+/**
+ * @file    BatchSolver.cpp
+ * @brief   Solve many puzzles at once on a work-stealing pool. Each puzzle is
+ *          a job that runs a slice of generations at a time, so a worker that
+ *          runs out of puzzles can take over another worker's unstarted ones,
+ *          and a long run does not keep the rest of a batch waiting behind
+ *          it. Every puzzle is seeded from its position in the batch, so the
+ *          results do not depend on the number of threads. With a
+ *          SolutionCache, a puzzle equivalent to one solved before is
+ *          answered from the cache, and equivalent puzzles within a batch are
+ *          solved only once.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#include <unordered_map>
+
+#include "BatchSolver.h"
+
+
+/** Constructor.
+ * @param threads  The number of worker threads, at least 1.
+ * @param pop  Size of the population to have each generation.
+ * @param gens  Maximum number of generations before giving up.
+ * @param slice  Generations each job runs before it may change hands.
+ */
+BatchSolver::BatchSolver(int threads, int pop, int gens, int slice) :
+    pool(threads), popSize(pop), maxGens(gens), sliceGens(slice),
+    settings(), cache(NULL), reused(0)
+{
+} // end constructor
+
+/** Destructor.
+ */
+BatchSolver::~BatchSolver()
+{
+} // end destructor
+
+/** Solve a batch of puzzles.
+ * @param puzzles  The puzzles to be solved.
+ * @param limits  Budgets and validation for each puzzle. Its deadline is
+ *                ignored.
+ * @param seconds  Time allowed each puzzle from when it is started; 0 or less
+ *                 for no limit.
+ * @param seed  Seeds the puzzles, in order; equal seeds give equal results.
+ * @param results  Set to one result per puzzle, in the same order.
+ * @pre No other call to solve() is in progress.
+ * @post None.
+ * @return The number of puzzles that were solved.
+ */
+size_t BatchSolver::solve(const vector<Puzzle>& puzzles,
+                          const SolveLimits& limits, double seconds,
+                          uint64_t seed, vector<SolveResult>& results)
+{
+    Random seeds(seed);
+    vector<Task*> jobs;
+    vector<size_t> twinOf(puzzles.size());      // the first equivalent puzzle
+    vector<Symmetry> changes(puzzles.size());
+    vector<string> canonical(puzzles.size());
+    unordered_map<string, size_t> firsts;       // by canonical form
+    size_t solved = 0;
+
+    results.resize(puzzles.size());
+    jobs.reserve(puzzles.size());
+
+    for (size_t i = 0; i < puzzles.size(); ++i)
+    {
+        uint64_t own = seeds.next();    // drawn even if unused, for stability
+
+        twinOf[i] = i;
+
+        if (cache != NULL && answer(puzzles[i], limits.validate,
+                                    canonical[i], changes[i], results[i]))
+        {
+            ++reused;
+            continue;
+        } // end if (cache != NULL && answer(...))
+
+        if (!canonical[i].empty())
+        {
+            pair<unordered_map<string, size_t>::iterator, bool> first =
+                firsts.insert(make_pair(canonical[i], i));
+
+            if (!first.second)
+            {
+                twinOf[i] = first.first->second;
+                ++reused;
+                continue;
+            } // end if (!first.second)
+        } // end if (!canonical[i].empty())
+
+        GeneticAlgorithm engine(puzzles[i], popSize, maxGens);
+
+        engine.seed(own);
+        engine.tune(settings);
+        jobs.push_back(new Job(engine, limits, seconds, sliceGens,
+                               results[i]));
+    } // end for (size_t i = 0; i < puzzles.size(); ++i)
+
+    pool.runAll(jobs);
+
+    for (size_t i = 0; i < puzzles.size(); ++i)
+    {
+        if (twinOf[i] != i)
+        {
+            carry(results[twinOf[i]], changes[twinOf[i]], changes[i],
+                  results[i]);
+        }
+        else if (!canonical[i].empty() && results[i].status == SOLVED)
+        {
+            remember(canonical[i], changes[i], results[i].best);
+        } // end if (twinOf[i] != i)
+
+        solved += results[i].status == SOLVED;
+    } // end for (size_t i = 0; i < puzzles.size(); ++i)
+
+    for (size_t i = 0; i < jobs.size(); ++i)
+    {
+        delete jobs[i];
+    } // end for (size_t i = 0; i < jobs.size(); ++i)
+
+    return solved;
+} // end solve(vector<Puzzle>&, SolveLimits&, double, uint64_t, ...)
+
+/** Answer puzzles from a cache where possible, and remember every solution
+ *  found in it. A puzzle answered from the cache is SOLVED in no generations.
+ * @param store  The cache, or NULL for none. It must outlast every later call
+ *               to solve().
+ * @pre No call to solve() is in progress.
+ * @post None.
+ */
+void BatchSolver::cacheWith(SolutionCache *store)
+{
+    cache = store;
+} // end cacheWith(SolutionCache*)
+
+/** Search every later puzzle with the given settings.
+ * @param chosen  The settings.
+ * @pre No call to solve() is in progress.
+ * @post On success, the settings are those chosen.
+ * @return true if chosen is usable with the population size, false otherwise.
+ */
+bool BatchSolver::tuneWith(const Tuning& chosen)
+{
+    if (!chosen.usable(popSize))
+    {
+        return false;
+    } // end if (!chosen.usable(popSize))
+
+    settings = chosen;
+
+    return true;
+} // end tuneWith(Tuning&)
+
+/** Provide the number of worker threads.
+ * @pre None.
+ * @post None.
+ * @return The number of workers.
+ */
+int BatchSolver::threads(void) const
+{
+    return pool.size();
+} // end threads()
+
+/** Provide the number of jobs that moved between workers.
+ * @pre None.
+ * @post None.
+ * @return The count of steals since construction.
+ */
+long BatchSolver::steals(void) const
+{
+    return pool.steals();
+} // end steals()
+
+/** Provide the number of puzzles answered without a run of their own, from
+ *  the cache or from an equivalent puzzle in the same batch.
+ * @pre None.
+ * @post None.
+ * @return The count since construction.
+ */
+long BatchSolver::answered(void) const
+{
+    return reused;
+} // end answered()
+
+/** Look a puzzle up in the cache. The cache holds solutions only, not whether
+ *  they were the only ones, so a puzzle to be validated is checked here as a
+ *  run would check it.
+ * @param clues  The puzzle.
+ * @param validate  Whether to answer only a puzzle with one solution.
+ * @param canonical  Set to its canonical form, or left empty if it has none.
+ * @param change  Set to the change that takes clues to canonical.
+ * @param result  Set on a hit to a SOLVED result holding the solution.
+ * @pre cache is not NULL.
+ * @post None.
+ * @return true on a hit, false on a miss or a puzzle that failed validation,
+ *         which a run is left to reject.
+ */
+bool BatchSolver::answer(const Puzzle& clues, bool validate,
+                         string& canonical, Symmetry& change,
+                         SolveResult& result)
+{
+    char cells[ROWS * COLUMNS], form[ROWS * COLUMNS], found[ROWS * COLUMNS];
+
+    clues.write(cells);
+
+    if (!Symmetry::canonicalize(cells, form, change))
+    {
+        return false;
+    } // end if (!Symmetry::canonicalize(cells, form, change))
+
+    canonical.assign(form, ROWS * COLUMNS);
+
+    if (!cache->find(form, found))
+    {
+        return false;
+    } // end if (!cache->find(form, found))
+
+    if (validate)
+    {
+        SolutionCounter checker;
+
+        if (checker.check(cells) != UNIQUE)
+        {
+            return false;
+        } // end if (checker.check(cells) != UNIQUE)
+    } // end if (validate)
+
+    change.undo(found, cells);
+    result.best.read(cells);
+    result.status = SOLVED;
+    result.generations = 0;
+    result.evaluations = 0;
+    result.validity = UNIQUE;
+    result.cutoffs.scored = 0;
+    result.cutoffs.culled = 0;
+    result.cutoffs.checksMade = 0;
+    result.cutoffs.checksSkipped = 0;
+
+    return true;
+} // end answer(Puzzle&, bool, string&, Symmetry&, SolveResult&)
+
+/** Add a solution to the cache.
+ * @param canonical  The canonical form of the puzzle solved.
+ * @param change  The change that takes the puzzle to canonical.
+ * @param solution  Its solution, in the orientation of the puzzle.
+ * @pre cache is not NULL.
+ * @post None.
+ */
+void BatchSolver::remember(const string& canonical, const Symmetry& change,
+                           const Puzzle& solution)
+{
+    char cells[ROWS * COLUMNS], solved[ROWS * COLUMNS];
+
+    solution.write(cells);
+    change.apply(cells, solved);
+    cache->insert(canonical.data(), solved);
+} // end remember(string&, Symmetry&, Puzzle&)
+
+/** Give a puzzle the result of an equivalent one, carried to its own
+ *  orientation.
+ * @param from  The result of the equivalent puzzle.
+ * @param fromChange  The change that takes the equivalent puzzle to the
+ *                    canonical form.
+ * @param toChange  The change that takes the puzzle to the canonical form.
+ * @param to  Set to from, with its best grid carried over.
+ * @pre None.
+ * @post None.
+ */
+void BatchSolver::carry(const SolveResult& from, const Symmetry& fromChange,
+                        const Symmetry& toChange, SolveResult& to)
+{
+    char cells[ROWS * COLUMNS], shared[ROWS * COLUMNS];
+
+    to = from;
+    from.best.write(cells);
+    fromChange.apply(cells, shared);
+    toChange.undo(shared, cells);
+    to.best.read(cells);
+} // end carry(SolveResult&, Symmetry&, Symmetry&, SolveResult&)
+
+/** Constructor.
+ * @param engine  The algorithm, seeded, for this puzzle.
+ * @param limits  Budgets and validation for this puzzle.
+ * @param seconds  Time allowed from the first slice; 0 for none.
+ * @param slice  Generations per call to run().
+ * @param result  Where to leave the outcome.
+ */
+BatchSolver::Job::Job(const GeneticAlgorithm& engine,
+                      const SolveLimits& limits, double seconds, int slice,
+                      SolveResult& result) :
+    engine(engine), limits(limits), seconds(seconds), slice(slice),
+    result(result), current(NULL)
+{
+    this->limits.hasDeadline = false;
+} // end constructor
+
+/** Destructor.
+ */
+BatchSolver::Job::~Job()
+{
+    delete current;
+} // end destructor
+
+/** Start the run if it has not been, then run one slice.
+ * @param worker  The index of the worker running the slice.
+ * @pre None.
+ * @post The outcome has been left in result if the run is over.
+ * @return true if there are generations left to run, false if not.
+ */
+bool BatchSolver::Job::run(int /* worker */)
+{
+    bool more;
+
+    if (current == NULL)
+    {
+        if (seconds > 0.0)
+        {
+            limits.hasDeadline = true;
+            limits.deadline = SolveLimits::within(seconds).deadline;
+        } // end if (seconds > 0.0)
+
+        current = new Population;
+        more = engine.begin(limits, *current, result) &&
+               engine.advance(limits, *current, result, slice);
+    }
+    else
+    {
+        more = engine.advance(limits, *current, result, slice);
+    } // end if (current == NULL)
+
+    if (!more)
+    {
+        engine.end(*current, result);
+        delete current;             // give the storage back while it is warm
+        current = NULL;
+    } // end if (!more)
+
+    return more;
+} // end run(int)
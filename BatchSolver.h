@@ -0,0 +1,204 @@
+/**
+ * @file    BatchSolver.h
+ * @brief   Solve many puzzles at once on a work-stealing pool. Each puzzle is
+ *          a job that runs a slice of generations at a time, so a worker that
+ *          runs out of puzzles can take over another worker's unstarted ones,
+ *          and a long run does not keep the rest of a batch waiting behind
+ *          it. Every puzzle is seeded from its position in the batch, so the
+ *          results do not depend on the number of threads. With a
+ *          SolutionCache, a puzzle equivalent to one solved before is
+ *          answered from the cache, and equivalent puzzles within a batch are
+ *          solved only once.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#ifndef _BATCHSOLVER_H
+#define	_BATCHSOLVER_H
+
+#include <string>
+#include <vector>
+
+#include "GeneticAlgorithm.h"
+#include "SolutionCache.h"
+#include "Symmetry.h"
+#include "WorkStealingPool.h"
+
+using namespace std;
+
+
+class BatchSolver
+{
+public:
+
+    /** Constructor.
+     * @param threads  The number of worker threads, at least 1.
+     * @param pop  Size of the population to have each generation.
+     * @param gens  Maximum number of generations before giving up.
+     * @param slice  Generations each job runs before it may change hands.
+     */
+    BatchSolver(int threads, int pop, int gens, int slice);
+
+    /** Destructor.
+     */
+    virtual ~BatchSolver();
+
+    /** Solve a batch of puzzles.
+     * @param puzzles  The puzzles to be solved.
+     * @param limits  Budgets and validation for each puzzle. Its deadline is
+     *                ignored.
+     * @param seconds  Time allowed each puzzle from when it is started; 0 or
+     *                 less for no limit.
+     * @param seed  Seeds the puzzles, in order; equal seeds give equal
+     *              results.
+     * @param results  Set to one result per puzzle, in the same order.
+     * @pre No other call to solve() is in progress.
+     * @post None.
+     * @return The number of puzzles that were solved.
+     */
+    size_t solve(const vector<Puzzle>& puzzles, const SolveLimits& limits,
+                 double seconds, uint64_t seed, vector<SolveResult>& results);
+
+    /** Answer puzzles from a cache where possible, and remember every
+     *  solution found in it. A puzzle answered from the cache is SOLVED in
+     *  no generations.
+     * @param store  The cache, or NULL for none. It must outlast every later
+     *               call to solve().
+     * @pre No call to solve() is in progress.
+     * @post None.
+     */
+    void cacheWith(SolutionCache *store);
+
+    /** Search every later puzzle with the given settings.
+     * @param chosen  The settings.
+     * @pre No call to solve() is in progress.
+     * @post On success, the settings are those chosen.
+     * @return true if chosen is usable with the population size, false
+     *         otherwise.
+     */
+    bool tuneWith(const Tuning& chosen);
+
+    /** Provide the number of worker threads.
+     * @pre None.
+     * @post None.
+     * @return The number of workers.
+     */
+    int threads(void) const;
+
+    /** Provide the number of jobs that moved between workers.
+     * @pre None.
+     * @post None.
+     * @return The count of steals since construction.
+     */
+    long steals(void) const;
+
+    /** Provide the number of puzzles answered without a run of their own,
+     *  from the cache or from an equivalent puzzle in the same batch.
+     * @pre None.
+     * @post None.
+     * @return The count since construction.
+     */
+    long answered(void) const;
+
+private:
+
+    /** One puzzle of a batch. Its population exists only between the first
+     *  slice and the last, so a batch holds about one per worker.
+     */
+    class Job : public Task
+    {
+    public:
+
+        /** Constructor.
+         * @param engine  The algorithm, seeded, for this puzzle.
+         * @param limits  Budgets and validation for this puzzle.
+         * @param seconds  Time allowed from the first slice; 0 for none.
+         * @param slice  Generations per call to run().
+         * @param result  Where to leave the outcome.
+         */
+        Job(const GeneticAlgorithm& engine, const SolveLimits& limits,
+            double seconds, int slice, SolveResult& result);
+
+        /** Destructor.
+         */
+        virtual ~Job();
+
+        /** Start the run if it has not been, then run one slice.
+         * @param worker  The index of the worker running the slice.
+         * @pre None.
+         * @post The outcome has been left in result if the run is over.
+         * @return true if there are generations left to run, false if not.
+         */
+        virtual bool run(int worker);
+
+    private:
+
+        GeneticAlgorithm engine;
+        SolveLimits limits;
+        double seconds;
+        int slice;
+        SolveResult& result;
+        Population *current;    // NULL before the first slice and after last
+
+        // Not copyable; a Job refers to its result.
+        Job(const Job& orig);
+        void operator=(const Job& rhs);
+
+    };
+
+    WorkStealingPool pool;
+    int popSize;
+    int maxGens;
+    int sliceGens;
+    Tuning settings;
+    SolutionCache *cache;       // NULL for none
+    long reused;                // puzzles answered without a run
+
+    /** Look a puzzle up in the cache. The cache holds solutions only, not
+     *  whether they were the only ones, so a puzzle to be validated is
+     *  checked here as a run would check it.
+     * @param clues  The puzzle.
+     * @param validate  Whether to answer only a puzzle with one solution.
+     * @param canonical  Set to its canonical form, or left empty if it has
+     *                   none.
+     * @param change  Set to the change that takes clues to canonical.
+     * @param result  Set on a hit to a SOLVED result holding the solution.
+     * @pre cache is not NULL.
+     * @post None.
+     * @return true on a hit, false on a miss or a puzzle that failed
+     *         validation, which a run is left to reject.
+     */
+    bool answer(const Puzzle& clues, bool validate, string& canonical,
+                Symmetry& change, SolveResult& result);
+
+    /** Add a solution to the cache.
+     * @param canonical  The canonical form of the puzzle solved.
+     * @param change  The change that takes the puzzle to canonical.
+     * @param solution  Its solution, in the orientation of the puzzle.
+     * @pre cache is not NULL.
+     * @post None.
+     */
+    void remember(const string& canonical, const Symmetry& change,
+                  const Puzzle& solution);
+
+    /** Give a puzzle the result of an equivalent one, carried to its own
+     *  orientation.
+     * @param from  The result of the equivalent puzzle.
+     * @param fromChange  The change that takes the equivalent puzzle to the
+     *                    canonical form.
+     * @param toChange  The change that takes the puzzle to the canonical
+     *                  form.
+     * @param to  Set to from, with its best grid carried over.
+     * @pre None.
+     * @post None.
+     */
+    static void carry(const SolveResult& from, const Symmetry& fromChange,
+                      const Symmetry& toChange, SolveResult& to);
+
+    // Not copyable; the pool owns threads.
+    BatchSolver(const BatchSolver& orig);
+    void operator=(const BatchSolver& rhs);
+
+};
+
+#endif	/* _BATCHSOLVER_H */
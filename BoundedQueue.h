@@ -0,0 +1,121 @@
+/**
+ * @file    BoundedQueue.h
+ * @brief   A first-in, first-out queue between threads that holds at most a
+ *          fixed number of items. A producer waits while it is full and a
+ *          consumer while it is empty, so a fast stage cannot run away from
+ *          a slow one. Items are swapped in and out rather than copied, so
+ *          buffers can be passed back and forth and reused.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#ifndef _BOUNDEDQUEUE_H
+#define	_BOUNDEDQUEUE_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+using namespace std;
+
+
+template <class T>
+class BoundedQueue
+{
+public:
+
+    /** Constructor.
+     * @param limit  The most items to hold at once, at least 1.
+     */
+    explicit BoundedQueue(size_t limit) : lock(), notFull(), notEmpty(),
+                                          items(), most(limit), closed(false)
+    {
+    } // end constructor
+
+    /** Add an item at the back, waiting for room if need be.
+     * @param item  The item, which is swapped into the queue.
+     * @pre None.
+     * @post On success, item holds a default-constructed T.
+     * @return true if the item was added, false if the queue was closed.
+     */
+    bool push(T& item)
+    {
+        unique_lock<mutex> guard(lock);
+
+        while (items.size() >= most && !closed)
+        {
+            notFull.wait(guard);
+        } // end while (items.size() >= most && !closed)
+
+        if (closed)
+        {
+            return false;
+        } // end if (closed)
+
+        items.push_back(T());
+        swap(items.back(), item);
+        notEmpty.notify_one();
+
+        return true;
+    } // end push(T&)
+
+    /** Take the item at the front, waiting for one if need be.
+     * @param item  Set to the item; what it held before is discarded.
+     * @pre None.
+     * @post None.
+     * @return true if an item was taken, false if the queue was closed.
+     */
+    bool pop(T& item)
+    {
+        unique_lock<mutex> guard(lock);
+
+        while (items.empty() && !closed)
+        {
+            notEmpty.wait(guard);
+        } // end while (items.empty() && !closed)
+
+        if (closed)
+        {
+            return false;
+        } // end if (closed)
+
+        swap(item, items.front());
+        items.pop_front();
+        notFull.notify_one();
+
+        return true;
+    } // end pop(T&)
+
+    /** Stop the queue. Every waiting and later push() and pop() fails at
+     *  once; items still held are dropped.
+     * @pre None.
+     * @post The queue is closed.
+     */
+    void close(void)
+    {
+        lock_guard<mutex> guard(lock);
+
+        closed = true;
+        items.clear();
+        notFull.notify_all();
+        notEmpty.notify_all();
+    } // end close()
+
+private:
+
+    mutex lock;
+    condition_variable notFull;
+    condition_variable notEmpty;
+    deque<T> items;
+    size_t most;
+    bool closed;
+
+    // Not copyable; threads wait on it.
+    BoundedQueue(const BoundedQueue& orig);
+    void operator=(const BoundedQueue& rhs);
+
+};
+
+#endif	/* _BOUNDEDQUEUE_H */
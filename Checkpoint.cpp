@@ -0,0 +1,232 @@
+/**
+ * @file    Checkpoint.cpp
+ * @brief   Saves and restores the complete state of a GeneticAlgorithm run so
+ *          that a long run can survive a restart. A resumed run continues
+ *          bit-for-bit as the original would have. Files are written by a
+ *          background thread so that the generation loop never waits on I/O.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "Checkpoint.h"
+
+// File layout, in host byte order:
+//   magic[4] version:u32 popSize:i32 maxGens:i32 mutantiness:f64
+//   survival:f64 children:i32 generation:i32 evaluations:i64 rngState:u64
+//   preGen[PACKED_SIZE] count:u32 population[count][PACKED_SIZE]
+static const char MAGIC[4] = { 'S', 'G', 'A', 'C' };
+static const uint32_t VERSION = 4;   // 2: mutation draws from candidates
+                                     // 3: ties in selection go to the first
+                                     // 4: survival and children are saved
+
+
+/** Default constructor.
+ */
+Checkpoint::Checkpoint() : popSize(0), maxGens(0), mutantiness(0.0),
+                           survival(0.0), children(0), generation(0),
+                           evaluations(0), rngState(0), preGen(),
+                           population()
+{
+} // end default constructor
+
+/** Write this checkpoint to a file. The file is replaced atomically, so an
+ *  interrupted write leaves the previous checkpoint intact.
+ * @param path  The file to write.
+ * @pre None.
+ * @post On success, path holds this checkpoint.
+ * @return true if the file was written, false otherwise.
+ */
+bool Checkpoint::save(const string& path) const
+{
+    string temp = path + ".tmp";
+    vector<unsigned char> body((population.size() + 1) * PACKED_SIZE);
+    uint32_t count = population.size();
+    int64_t evals = evaluations;
+    int32_t fields[4] = { popSize, maxGens, children, generation };
+    FILE *out = fopen(temp.c_str(), "wb");
+    bool good;
+
+    if (out == NULL)
+    {
+        return false;
+    } // end if (out == NULL)
+
+    preGen.pack(&body[0]);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        population[i].pack(&body[(i + 1) * PACKED_SIZE]);
+    } // end for (uint32_t i = 0; i < count; ++i)
+
+    good = fwrite(MAGIC, sizeof(MAGIC), 1, out) == 1 &&
+           fwrite(&VERSION, sizeof(VERSION), 1, out) == 1 &&
+           fwrite(fields, sizeof(fields[0]), 2, out) == 2 &&
+           fwrite(&mutantiness, sizeof(mutantiness), 1, out) == 1 &&
+           fwrite(&survival, sizeof(survival), 1, out) == 1 &&
+           fwrite(&fields[2], sizeof(fields[2]), 2, out) == 2 &&
+           fwrite(&evals, sizeof(evals), 1, out) == 1 &&
+           fwrite(&rngState, sizeof(rngState), 1, out) == 1 &&
+           fwrite(&body[0], PACKED_SIZE, 1, out) == 1 &&
+           fwrite(&count, sizeof(count), 1, out) == 1 &&
+           (count == 0 ||
+            fwrite(&body[PACKED_SIZE], PACKED_SIZE, count, out) == count);
+    good = (fclose(out) == 0) && good;
+
+    if (!good || rename(temp.c_str(), path.c_str()) != 0)
+    {
+        remove(temp.c_str());
+        return false;
+    } // end if (!good || rename(temp.c_str(), path.c_str()) != 0)
+
+    return true;
+} // end save(string&)
+
+/** Read a checkpoint from a file written by save().
+ * @param path  The file to read.
+ * @pre None.
+ * @post On success, this checkpoint holds the contents of path.
+ * @return true if a valid checkpoint was read, false otherwise.
+ */
+bool Checkpoint::load(const string& path)
+{
+    char magic[4];
+    uint32_t version, count;
+    int32_t fields[4];
+    int64_t evals;
+    unsigned char packed[PACKED_SIZE];
+    Checkpoint loaded;
+    FILE *in = fopen(path.c_str(), "rb");
+    bool good;
+
+    if (in == NULL)
+    {
+        return false;
+    } // end if (in == NULL)
+
+    good = fread(magic, sizeof(magic), 1, in) == 1 &&
+           memcmp(magic, MAGIC, sizeof(MAGIC)) == 0 &&
+           fread(&version, sizeof(version), 1, in) == 1 &&
+           version == VERSION &&
+           fread(fields, sizeof(fields[0]), 2, in) == 2 &&
+           fread(&loaded.mutantiness, sizeof(loaded.mutantiness), 1, in) == 1 &&
+           fread(&loaded.survival, sizeof(loaded.survival), 1, in) == 1 &&
+           fread(&fields[2], sizeof(fields[2]), 2, in) == 2 &&
+           fread(&evals, sizeof(evals), 1, in) == 1 &&
+           fread(&loaded.rngState, sizeof(loaded.rngState), 1, in) == 1 &&
+           fread(packed, PACKED_SIZE, 1, in) == 1 &&
+           loaded.preGen.unpack(packed) &&
+           fread(&count, sizeof(count), 1, in) == 1 &&
+           loaded.rngState != 0;
+
+    if (good)
+    {
+        loaded.popSize = fields[0];
+        loaded.maxGens = fields[1];
+        loaded.children = fields[2];
+        loaded.generation = fields[3];
+        loaded.evaluations = evals;
+        loaded.population.resize(count);
+
+        for (uint32_t i = 0; i < count && good; ++i)
+        {
+            good = fread(packed, PACKED_SIZE, 1, in) == 1 &&
+                   loaded.population[i].unpack(packed);
+        } // end for (uint32_t i = 0; i < count && good; ++i)
+    } // end if (good)
+
+    fclose(in);
+
+    if (good)
+    {
+        *this = loaded;
+    } // end if (good)
+
+    return good;
+} // end load(string&)
+
+/** Constructor. Starts the background writer.
+ * @param path  The file to which every checkpoint is written.
+ */
+CheckpointWriter::CheckpointWriter(const string& path) :
+    file(path), pending(), writing(), hasPending(false), stopping(false),
+    failed(0), lock(), ready(), worker(&CheckpointWriter::run, this)
+{
+} // end constructor
+
+/** Destructor. Writes any checkpoint still pending, then stops the background
+ *  writer.
+ */
+CheckpointWriter::~CheckpointWriter()
+{
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+
+    ready.notify_one();
+    worker.join();
+} // end destructor
+
+/** Hand a checkpoint to the background writer. A checkpoint that has not
+ *  started writing yet is replaced, since only the newest one matters.
+ * @param snapshot  The checkpoint to write.
+ * @pre None.
+ * @post snapshot holds a spare buffer whose contents are unspecified, so that
+ *       its storage can be reused for the next checkpoint.
+ */
+void CheckpointWriter::submit(Checkpoint& snapshot)
+{
+    {
+        lock_guard<mutex> guard(lock);
+        swap(pending, snapshot);
+        hasPending = true;
+    }
+
+    ready.notify_one();
+} // end submit(Checkpoint&)
+
+/** Provide the number of checkpoints that could not be written.
+ * @pre None.
+ * @post None.
+ * @return The count of failed writes so far.
+ */
+int CheckpointWriter::failures(void) const
+{
+    lock_guard<mutex> guard(lock);
+
+    return failed;
+} // end failures()
+
+/** Write checkpoints as they are submitted until told to stop.
+ * @pre None.
+ * @post Every submitted checkpoint has been written or replaced.
+ */
+void CheckpointWriter::run(void)
+{
+    unique_lock<mutex> guard(lock);
+
+    while (true)
+    {
+        while (!hasPending && !stopping)
+        {
+            ready.wait(guard);
+        } // end while (!hasPending && !stopping)
+
+        if (!hasPending)            // stopping, with nothing left to write
+        {
+            break;
+        } // end if (!hasPending)
+
+        swap(writing, pending);
+        hasPending = false;
+
+        // Write without holding the lock so submit() never waits on I/O.
+        guard.unlock();
+        bool good = writing.save(file);
+        guard.lock();
+
+        failed += !good;
+    } // end while (true)
+} // end run()
@@ -0,0 +1,119 @@
+/**
+ * @file    Checkpoint.h
+ * @brief   Saves and restores the complete state of a GeneticAlgorithm run so
+ *          that a long run can survive a restart. A resumed run continues
+ *          bit-for-bit as the original would have. Files are written by a
+ *          background thread so that the generation loop never waits on I/O.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#ifndef _CHECKPOINT_H
+#define	_CHECKPOINT_H
+
+#include <condition_variable>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Puzzle.h"
+
+using namespace std;
+
+
+/** Everything needed to continue a run from the top of a generation.
+ */
+struct Checkpoint
+{
+    /** Default constructor.
+     */
+    Checkpoint();
+
+    /** Write this checkpoint to a file. The file is replaced atomically, so an
+     *  interrupted write leaves the previous checkpoint intact.
+     * @param path  The file to write.
+     * @pre None.
+     * @post On success, path holds this checkpoint.
+     * @return true if the file was written, false otherwise.
+     */
+    bool save(const string& path) const;
+
+    /** Read a checkpoint from a file written by save().
+     * @param path  The file to read.
+     * @pre None.
+     * @post On success, this checkpoint holds the contents of path.
+     * @return true if a valid checkpoint was read, false otherwise.
+     */
+    bool load(const string& path);
+
+    int popSize;
+    int maxGens;
+    double mutantiness;
+    double survival;
+    int children;
+    int generation;             // generations already selected
+    long evaluations;           // Puzzles already scored
+    uint64_t rngState;
+    Puzzle preGen;
+    vector<Puzzle> population;  // as bred, about to be selected
+
+};
+
+
+class CheckpointWriter
+{
+public:
+
+    /** Constructor. Starts the background writer.
+     * @param path  The file to which every checkpoint is written.
+     */
+    explicit CheckpointWriter(const string& path);
+
+    /** Destructor. Writes any checkpoint still pending, then stops the
+     *  background writer.
+     */
+    virtual ~CheckpointWriter();
+
+    /** Hand a checkpoint to the background writer. A checkpoint that has not
+     *  started writing yet is replaced, since only the newest one matters.
+     * @param snapshot  The checkpoint to write.
+     * @pre None.
+     * @post snapshot holds a spare buffer whose contents are unspecified, so
+     *       that its storage can be reused for the next checkpoint.
+     */
+    void submit(Checkpoint& snapshot);
+
+    /** Provide the number of checkpoints that could not be written.
+     * @pre None.
+     * @post None.
+     * @return The count of failed writes so far.
+     */
+    int failures(void) const;
+
+private:
+
+    string file;
+    Checkpoint pending;
+    Checkpoint writing;
+    bool hasPending;
+    bool stopping;
+    int failed;
+    mutable mutex lock;
+    condition_variable ready;
+    thread worker;
+
+    /** Write checkpoints as they are submitted until told to stop.
+     * @pre None.
+     * @post Every submitted checkpoint has been written or replaced.
+     */
+    void run(void);
+
+    // Not copyable; the writer owns a thread.
+    CheckpointWriter(const CheckpointWriter& orig);
+    void operator=(const CheckpointWriter& rhs);
+
+};
+
+#endif	/* _CHECKPOINT_H */
@@ -0,0 +1,169 @@
+/**
+ * @file    Corpus.cpp
+ * @brief   Reads and writes files of many puzzles. The text form has one
+ *          puzzle of 81 digits per line, as in test.txt; other lines are
+ *          skipped. The binary form is a header followed by each puzzle
+ *          packed two cells to a byte. Reading tells the forms apart by the
+ *          header.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+
+#include "Corpus.h"
+
+// Binary layout, in host byte order: magic[4] count:u32 puzzles[count][PACKED]
+static const char MAGIC[4] = { 'S', 'G', 'A', 'P' };
+
+
+/** Read every puzzle in a file.
+ * @param path  The file, in either form, or "-" for standard input.
+ * @param puzzles  The puzzles read are appended here.
+ * @pre None.
+ * @post None.
+ * @return true if the file was read, false otherwise.
+ */
+bool readCorpus(const string& path, vector<Puzzle>& puzzles)
+{
+    FILE *in = path == "-" ? stdin : fopen(path.c_str(), "rb");
+    char magic[sizeof(MAGIC)];
+    bool good = true;
+
+    if (in == NULL)
+    {
+        return false;
+    } // end if (in == NULL)
+
+    size_t got = fread(magic, 1, sizeof(magic), in);
+
+    if (got == sizeof(MAGIC) && memcmp(magic, MAGIC, sizeof(MAGIC)) == 0)
+    {
+        uint32_t count;
+        unsigned char packed[PACKED_SIZE];
+        Puzzle puzzle;
+
+        good = fread(&count, sizeof(count), 1, in) == 1;
+
+        for (uint32_t i = 0; i < count && good; ++i)
+        {
+            good = fread(packed, PACKED_SIZE, 1, in) == 1 &&
+                   puzzle.unpack(packed);
+            if (good)
+            {
+                puzzles.push_back(puzzle);
+            } // end if (good)
+        } // end for (uint32_t i = 0; i < count && good; ++i)
+    }
+    else                            // text: one puzzle of 81 digits per line
+    {
+        char cells[ROWS * COLUMNS];
+        int digits = 0, c;
+        size_t next = 0;            // the bytes read as magic come first
+        Puzzle puzzle;
+
+        while (true)
+        {
+            if (next < got)
+            {
+                c = static_cast<unsigned char>(magic[next++]);
+            }
+            else if ((c = fgetc(in)) == EOF)
+            {
+                break;
+            } // end if (next < got)
+
+            if (c == '\n')
+            {
+                if (digits == ROWS * COLUMNS && puzzle.read(cells))
+                {
+                    puzzles.push_back(puzzle);
+                } // end if (digits == ROWS * COLUMNS && puzzle.read(cells))
+
+                digits = 0;
+            }
+            else if (isdigit(c))
+            {
+                if (digits < ROWS * COLUMNS)
+                {
+                    cells[digits] = c;
+                } // end if (digits < ROWS * COLUMNS)
+
+                ++digits;
+            } // end if (c == '\n')
+        } // end while (true)
+
+        if (digits == ROWS * COLUMNS && puzzle.read(cells))  // no final '\n'
+        {
+            puzzles.push_back(puzzle);
+        } // end if (digits == ROWS * COLUMNS && puzzle.read(cells))
+    } // end if (got == sizeof(MAGIC) && ...)
+
+    good = good && !ferror(in);
+
+    if (in != stdin)
+    {
+        fclose(in);
+    } // end if (in != stdin)
+
+    return good;
+} // end readCorpus(string&, vector<Puzzle>&)
+
+/** Write puzzles to a file.
+ * @param path  The file, or "-" for standard output.
+ * @param puzzles  The puzzles to write.
+ * @param binary  Whether to use the packed form instead of text.
+ * @pre None.
+ * @post None.
+ * @return true if the file was written, false otherwise.
+ */
+bool writeCorpus(const string& path, const vector<Puzzle>& puzzles,
+                 bool binary)
+{
+    FILE *out = path == "-" ? stdout : fopen(path.c_str(), "wb");
+    vector<unsigned char> body;
+    size_t size = binary ? PACKED_SIZE : ROWS * COLUMNS + 1;
+    bool good;
+
+    if (out == NULL)
+    {
+        return false;
+    } // end if (out == NULL)
+
+    // Build the whole file in memory so it goes out in one write.
+    body.resize(puzzles.size() * size);
+
+    for (size_t i = 0; i < puzzles.size(); ++i)
+    {
+        if (binary)
+        {
+            puzzles[i].pack(&body[i * size]);
+        }
+        else
+        {
+            puzzles[i].write(reinterpret_cast<char*>(&body[i * size]));
+            body[i * size + ROWS * COLUMNS] = '\n';
+        } // end if (binary)
+    } // end for (size_t i = 0; i < puzzles.size(); ++i)
+
+    if (binary)
+    {
+        uint32_t count = puzzles.size();
+
+        good = fwrite(MAGIC, sizeof(MAGIC), 1, out) == 1 &&
+               fwrite(&count, sizeof(count), 1, out) == 1;
+    }
+    else
+    {
+        good = true;
+    } // end if (binary)
+
+    good = good && (body.empty() ||
+                    fwrite(&body[0], body.size(), 1, out) == 1);
+    good = (out == stdout ? fflush(out) == 0 : fclose(out) == 0) && good;
+
+    return good;
+} // end writeCorpus(string&, vector<Puzzle>&, bool)
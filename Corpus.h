@@ -0,0 +1,43 @@
+/**
+ * @file    Corpus.h
+ * @brief   Reads and writes files of many puzzles. The text form has one
+ *          puzzle of 81 digits per line, as in test.txt; other lines are
+ *          skipped. The binary form is a header followed by each puzzle
+ *          packed two cells to a byte. Reading tells the forms apart by the
+ *          header.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#ifndef _CORPUS_H
+#define	_CORPUS_H
+
+#include <string>
+#include <vector>
+
+#include "Puzzle.h"
+
+using namespace std;
+
+
+/** Read every puzzle in a file.
+ * @param path  The file, in either form, or "-" for standard input.
+ * @param puzzles  The puzzles read are appended here.
+ * @pre None.
+ * @post None.
+ * @return true if the file was read, false otherwise.
+ */
+bool readCorpus(const string& path, vector<Puzzle>& puzzles);
+
+/** Write puzzles to a file.
+ * @param path  The file, or "-" for standard output.
+ * @param puzzles  The puzzles to write.
+ * @param binary  Whether to use the packed form instead of text.
+ * @pre None.
+ * @post None.
+ * @return true if the file was written, false otherwise.
+ */
+bool writeCorpus(const string& path, const vector<Puzzle>& puzzles,
+                 bool binary);
+
+#endif	/* _CORPUS_H */
@@ -0,0 +1,198 @@
+/**
+ * @file    FitnessEvaluator.cpp
+ * @brief   Scores candidate solutions to one particular puzzle. Every Puzzle
+ *          evolved from a puzzle keeps its clues, so the comparisons that
+ *          Puzzle::fitnessOf() makes between two clues give the same answer
+ *          every time. The evaluator makes them once, when it is built, and
+ *          keeps for each row, column and nonet only the digits its clues
+ *          hold and the list of its free cells. Scoring then checks each free
+ *          cell once per unit, so a puzzle with more clues scores faster. A
+ *          score can also be cut short once it is sure to fall below a
+ *          cutoff, such as the worst fitness that can still survive.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#include "FitnessEvaluator.h"
+#include "Profiler.h"
+
+
+/** Find a cell of a unit.
+ * @param unit  The unit: rows first, then columns, then nonets.
+ * @param index  Which of its nine cells, in reading order.
+ * @pre None.
+ * @post None.
+ * @return The index of the cell in the grid.
+ */
+static int unitCell(int unit, int index)
+{
+    if (unit < ROWS)
+    {
+        return unit * COLUMNS + index;
+    }
+    else if (unit < ROWS + COLUMNS)
+    {
+        return index * COLUMNS + unit - ROWS;
+    } // end if (unit < ROWS)
+
+    int nonet = unit - ROWS - COLUMNS;
+
+    return (nonet / 3 * 3 + index / 3) * COLUMNS + nonet % 3 * 3 + index % 3;
+} // end unitCell(int, int)
+
+
+/** Default constructor. Builds an evaluator for a puzzle with no clues, which
+ *  scores any cells as Puzzle::fitnessOf() does.
+ */
+FitnessEvaluator::FitnessEvaluator()
+{
+    char blank[ROWS * COLUMNS];
+
+    for (int i = 0; i < ROWS * COLUMNS; ++i)
+    {
+        blank[i] = '0';
+    } // end for (int i = 0; i < ROWS * COLUMNS; ++i)
+
+    compile(blank);
+} // end default constructor
+
+/** Constructor.
+ * @param clues  The puzzle whose candidate solutions will be scored.
+ */
+FitnessEvaluator::FitnessEvaluator(const Puzzle& clues)
+{
+    char cells[ROWS * COLUMNS];
+
+    clues.write(cells);
+    compile(cells);
+} // end constructor
+
+/** Calculate the fitness of a candidate solution, as Puzzle::fitnessOf()
+ *  would. That takes one point for each empty cell, and one for each cell of
+ *  a unit whose digit appears again later in the unit; in other words, for
+ *  every unit, the number of its filled cells less the number of distinct
+ *  digits among them.
+ * @param cells  ROWS * COLUMNS chars, each an ASCII digit 0-9.
+ * @pre Every clue of the puzzle this evaluator was built for is in place in
+ *      cells.
+ * @post None.
+ * @return The fitness of cells as a solution, from -135 to 81.
+ */
+int FitnessEvaluator::fitness(const char *cells) const
+{
+    CutoffCounters unused = { 0, 0, 0, 0 };
+
+    return fitness(cells, CULLED, unused);
+} // end fitness(char*)
+
+/** Calculate the fitness of a candidate solution only as far as needed to
+ *  tell whether it reaches a cutoff. Fitness only falls as checks are made,
+ *  so scoring stops as soon as it drops below cutoff.
+ * @param cells  ROWS * COLUMNS chars, each an ASCII digit 0-9.
+ * @param cutoff  The least fitness of any use to the caller.
+ * @param counters  Counts the scores and checks made and avoided.
+ * @pre Every clue of the puzzle this evaluator was built for is in place in
+ *      cells.
+ * @post counters include the work of this call.
+ * @return The fitness of cells if it is at least cutoff, CULLED if not.
+ */
+int FitnessEvaluator::fitness(const char *cells, int cutoff,
+                              CutoffCounters& counters) const
+{
+    PROFILE_SCOPE(PROFILE_FITNESS);
+    int quality = base;
+
+    // A full score, asked for with no cutoff, is no candidate for culling.
+    counters.scored += cutoff > CULLED ? 1 : 0;
+
+    // The row units come first, and hold each free cell exactly once.
+    for (int i = 0; i < freeCells; ++i)
+    {
+        quality -= cells[members[i]] == '0';
+    } // end for (int i = 0; i < freeCells; ++i)
+
+    for (int unit = 0; unit < units; ++unit)
+    {
+        int seen = clueMask[unit];
+
+        for (int i = start[unit]; i < start[unit + 1]; ++i)
+        {
+            int bit = (1 << (cells[members[i]] - '0')) >> 1;   // 0 if empty
+
+            quality -= (seen & bit) != 0;
+            seen |= bit;
+        } // end for (int i = start[unit]; i < start[unit + 1]; ++i)
+
+        if (quality < cutoff)
+        {
+            counters.culled += 1;
+            counters.checksMade += start[unit + 1];
+            counters.checksSkipped += start[units] - start[unit + 1];
+
+            return CULLED;
+        } // end if (quality < cutoff)
+    } // end for (int unit = 0; unit < units; ++unit)
+
+    counters.checksMade += start[units];
+
+    return quality;
+} // end fitness(char*, int, CutoffCounters&)
+
+/** Provide the number of cell checks a full score makes.
+ * @pre None.
+ * @post None.
+ * @return Three checks for every free cell of the puzzle.
+ */
+int FitnessEvaluator::checks(void) const
+{
+    return start[units];
+} // end checks()
+
+/** Find the clues and free cells of every unit.
+ * @param clues  ROWS * COLUMNS chars, '0' for a free cell.
+ * @pre None.
+ * @post Every field describes clues.
+ */
+void FitnessEvaluator::compile(const char *clues)
+{
+    int placed = 0;
+
+    base = ROWS * COLUMNS;
+    units = 0;
+    freeCells = 0;
+    start[0] = 0;
+
+    for (int unit = 0; unit < UNITS; ++unit)
+    {
+        int mask = 0, first = placed;
+
+        for (int i = 0; i < 9; ++i)
+        {
+            int cell = unitCell(unit, i);
+
+            if (clues[cell] == '0')
+            {
+                members[placed++] = cell;
+            }
+            else
+            {
+                int bit = 1 << (clues[cell] - '1');
+
+                base -= (mask & bit) != 0;  // clues in conflict
+                mask |= bit;
+            } // end if (clues[cell] == '0')
+        } // end for (int i = 0; i < 9; ++i)
+
+        // A unit of clues alone is settled; it needs no checks at all.
+        if (placed > first)
+        {
+            clueMask[units] = mask;
+            start[++units] = placed;
+        } // end if (placed > first)
+
+        if (unit == ROWS - 1)
+        {
+            freeCells = placed;
+        } // end if (unit == ROWS - 1)
+    } // end for (int unit = 0; unit < UNITS; ++unit)
+} // end compile(char*)
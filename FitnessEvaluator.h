@@ -0,0 +1,101 @@
+/**
+ * @file    FitnessEvaluator.h
+ * @brief   Scores candidate solutions to one particular puzzle. Every Puzzle
+ *          evolved from a puzzle keeps its clues, so the comparisons that
+ *          Puzzle::fitnessOf() makes between two clues give the same answer
+ *          every time. The evaluator makes them once, when it is built, and
+ *          keeps for each row, column and nonet only the digits its clues
+ *          hold and the list of its free cells. Scoring then checks each free
+ *          cell once per unit, so a puzzle with more clues scores faster. A
+ *          score can also be cut short once it is sure to fall below a
+ *          cutoff, such as the worst fitness that can still survive.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#ifndef _FITNESSEVALUATOR_H
+#define	_FITNESSEVALUATOR_H
+
+#include "Puzzle.h"
+
+using namespace std;
+
+const int UNITS = ROWS + COLUMNS + ROWS;    // rows, columns and nonets
+const int CULLED = -1000;       // below any fitness; a score cut short
+
+
+/** Work done and avoided by scoring against a cutoff.
+ */
+struct CutoffCounters
+{
+    long scored;            // scores made against a cutoff
+    long culled;            // ... of which were cut short
+    long checksMade;        // cell checks made
+    long checksSkipped;     // cell checks avoided by cutting scores short
+};
+
+
+class FitnessEvaluator
+{
+public:
+
+    /** Default constructor. Builds an evaluator for a puzzle with no clues,
+     *  which scores any cells as Puzzle::fitnessOf() does.
+     */
+    FitnessEvaluator();
+
+    /** Constructor.
+     * @param clues  The puzzle whose candidate solutions will be scored.
+     */
+    explicit FitnessEvaluator(const Puzzle& clues);
+
+    /** Calculate the fitness of a candidate solution, as Puzzle::fitnessOf()
+     *  would.
+     * @param cells  ROWS * COLUMNS chars, each an ASCII digit 0-9.
+     * @pre Every clue of the puzzle this evaluator was built for is in place
+     *      in cells.
+     * @post None.
+     * @return The fitness of cells as a solution, from -135 to 81.
+     */
+    int fitness(const char *cells) const;
+
+    /** Calculate the fitness of a candidate solution only as far as needed
+     *  to tell whether it reaches a cutoff. Fitness only falls as checks are
+     *  made, so scoring stops as soon as it drops below cutoff.
+     * @param cells  ROWS * COLUMNS chars, each an ASCII digit 0-9.
+     * @param cutoff  The least fitness of any use to the caller.
+     * @param counters  Counts the scores and checks made and avoided.
+     * @pre Every clue of the puzzle this evaluator was built for is in place
+     *      in cells.
+     * @post counters include the work of this call.
+     * @return The fitness of cells if it is at least cutoff, CULLED if not.
+     */
+    int fitness(const char *cells, int cutoff,
+                CutoffCounters& counters) const;
+
+    /** Provide the number of cell checks a full score makes.
+     * @pre None.
+     * @post None.
+     * @return Three checks for every free cell of the puzzle.
+     */
+    int checks(void) const;
+
+private:
+
+    int base;                   // IDEAL less the conflicts among the clues
+    int units;                  // units with at least one free cell
+    int freeCells;              // members of the row units, one per free cell
+    unsigned short clueMask[UNITS];         // digits held by clues, by unit
+    unsigned char start[UNITS + 1];         // first member of each unit
+    unsigned char members[3 * ROWS * COLUMNS];  // free cells, unit by unit
+
+    /** Find the clues and free cells of every unit.
+     * @param clues  ROWS * COLUMNS chars, '0' for a free cell.
+     * @pre None.
+     * @post Every field describes clues.
+     */
+    void compile(const char *clues);
+
+};
+
+#endif	/* _FITNESSEVALUATOR_H */
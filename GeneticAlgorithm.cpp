@@ -6,13 +6,91 @@
  * @date    November 22, 2011
  */
 
+#include <cstring>
+
 #include "GeneticAlgorithm.h"
+#include "Landscape.h"
+#include "Profiler.h"
+
+
+/** Default constructor. No deadline, no budgets and no validation.
+ */
+SolveLimits::SolveLimits() : hasDeadline(false), deadline(), maxEvaluations(0),
+                             maxMemory(0), validate(false)
+{
+} // end default constructor
+
+/** Build limits that expire a given number of seconds from now.
+ * @param seconds  Wall-clock time allowed from the moment of the call.
+ * @pre None.
+ * @post None.
+ * @return Limits with only the deadline set.
+ */
+SolveLimits SolveLimits::within(double seconds)
+{
+    SolveLimits limits;
+
+    limits.hasDeadline = true;
+    limits.deadline = Clock::now() +
+        std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(seconds));
+
+    return limits;
+} // end within(double)
+
+
+/** Default constructor. MUTANTINESS, SURVIVAL and CHILDREN.
+ */
+Tuning::Tuning() : mutantiness(MUTANTINESS), survival(SURVIVAL),
+                   children(CHILDREN)
+{
+} // end default constructor
+
+/** Find how many Puzzles survive each selection.
+ * @param popSize  The size of the first generation.
+ * @pre None.
+ * @post None.
+ * @return survival of popSize, rounded down.
+ */
+int Tuning::survivors(int popSize) const
+{
+    // The allowance keeps a share such as 0.1 of 70, held in binary as a
+    // hair under 7, from rounding down to 6.
+    return static_cast<int>(floor(popSize * survival + 1e-9));
+} // end survivors(int)
+
+/** Check that these settings can run with a population size.
+ * @param popSize  The size of the first generation.
+ * @pre None.
+ * @post None.
+ * @return true if mutantiness is in (0, 1], at least one Puzzle survives and
+ *         one is culled, and every survivor has a child; false otherwise.
+ */
+bool Tuning::usable(int popSize) const
+{
+    return mutantiness > 0.0 && mutantiness <= 1.0 &&
+           survivors(popSize) >= 1 && survivors(popSize) < popSize &&
+           children >= 1;
+} // end usable(int)
+
+
+/** Destructor.
+ */
+ProgressListener::~ProgressListener()
+{
+} // end destructor
 
 
 /** Default constructor.
  */
-GeneticAlgorithm::GeneticAlgorithm() : popSize(0), maxGens(0), preGen()
+GeneticAlgorithm::GeneticAlgorithm() : popSize(0), maxGens(0), settings(),
+                                       preGen(), rng(),
+                                       checkpointFile(), checkpointEvery(0),
+                                       restored(), replay(NULL),
+                                       listener(NULL), reported(0),
+                                       writer(NULL), snapshot()
 {
+    prepare();
 } // end default constructor
 
 /** Constructor.
@@ -21,22 +99,34 @@ GeneticAlgorithm::GeneticAlgorithm() : popSize(0), maxGens(0), preGen()
  * @param gens  Maximum number of generations before giving up.
  */
 GeneticAlgorithm::GeneticAlgorithm(Puzzle init, int pop, int gens) :
-                         preGen(init), popSize(pop), maxGens(gens)
+                         popSize(pop), maxGens(gens), settings(),
+                         preGen(init), rng(),
+                         checkpointFile(), checkpointEvery(0), restored(),
+                         replay(NULL), listener(NULL), reported(0),
+                         writer(NULL), snapshot()
 {
+    prepare();
 } // end constructor
 
 /** Copy constructor.
  * @param orig  The population to be copied.
  */
 GeneticAlgorithm::GeneticAlgorithm(const GeneticAlgorithm& orig) :
-    popSize(orig.popSize), maxGens(orig.maxGens), preGen(orig.preGen)
+    popSize(orig.popSize), maxGens(orig.maxGens), settings(orig.settings),
+    preGen(orig.preGen),
+    rng(orig.rng), checkpointFile(orig.checkpointFile),
+    checkpointEvery(orig.checkpointEvery), restored(orig.restored),
+    replay(orig.replay), listener(orig.listener), reported(0), writer(NULL),
+    snapshot()
 {
+    prepare();
 } // end copy constructor
 
 /** Destructor.
  */
 GeneticAlgorithm::~GeneticAlgorithm()
 {
+    delete writer;
 } // end destructor
 
 /** Attempt to evolve a solution to a Sudoku puzzle. Stops if a true solution
@@ -47,53 +137,502 @@ GeneticAlgorithm::~GeneticAlgorithm()
  */
 Puzzle GeneticAlgorithm::evolve(void)
 {
-    bool success = false;
+    return evolve(SolveLimits()).best;
+} // end evolve()
+
+/** Attempt to evolve a solution to a Sudoku puzzle without exceeding the given
+ *  limits. Limits are checked once per generation.
+ * @param limits  The deadline and budgets for this run.
+ * @pre None.
+ * @post None.
+ * @return The most fit solution found before a limit was hit, along with the
+ *         reason the run stopped.
+ */
+SolveResult GeneticAlgorithm::evolve(const SolveLimits& limits)
+{
     Population current;
 
-    current.reserve(popSize);
-    populate(current);
+    return evolve(limits, current);
+} // end evolve(SolveLimits&)
 
-    for (int i = 0; i < maxGens && !success; ++i)
+/** Attempt to evolve a solution as above, keeping the population in storage
+ *  supplied by the caller. Reusing one workspace across many calls avoids
+ *  allocating a population for every puzzle.
+ * @param limits  The deadline and budgets for this run.
+ * @param current  Storage for the population; its contents are discarded,
+ *                 but its capacity is kept.
+ * @pre None.
+ * @post current holds the final population.
+ * @return The most fit solution found before a limit was hit, along with the
+ *         reason the run stopped.
+ */
+SolveResult GeneticAlgorithm::evolve(const SolveLimits& limits,
+                                     Population& current)
+{
+    SolveResult result;
+
+    if (begin(limits, current, result))
     {
-        success = current.deleteWorst() == IDEAL;   // perfect fitness found
-        breed(current);
-    } // end for (int i = 0)
+        while (advance(limits, current, result, maxGens))
+        {
+        } // end while (advance(limits, current, result, maxGens))
+    } // end if (begin(limits, current, result))
 
-    return current.front();
-} // end evolve()
+    end(current, result);
+
+    return result;
+} // end evolve(SolveLimits&, Population&)
+
+/** Start a run that is to be advanced a slice of generations at a time, so
+ *  that a scheduler can interleave it with other work.
+ * @param limits  The deadline and budgets for this run.
+ * @param current  Storage for the population; its contents are discarded,
+ *                 but its capacity is kept.
+ * @param result  Set to the state of the run.
+ * @pre None.
+ * @post current holds the initial population, each Puzzle founding its
+ *       own lineage, unless the run is already over.
+ * @return true if the run should be advanced, false if it is already over;
+ *         end() must be called either way.
+ */
+bool GeneticAlgorithm::begin(const SolveLimits& limits, Population& current,
+                             SolveResult& result)
+{
+    result.status = GENERATIONS_EXHAUSTED;
+    result.generations = 0;
+    result.evaluations = 0;
+    result.validity = UNIQUE;
+    reported = CULLED;
+    current.clear();
+    current.scoreWith(&evaluator);
+
+    // A puzzle that cannot be solved, or solved only one way, would use the
+    // whole budget for nothing; exact search finds that out in microseconds.
+    if (limits.validate)
+    {
+        char cells[ROWS * COLUMNS];
+        SolutionCounter checker;
+
+        preGen.write(cells);
+        result.validity = checker.check(cells);
+
+        if (result.validity != UNIQUE)
+        {
+            result.status = REJECTED;
+            return false;
+        } // end if (result.validity != UNIQUE)
+    } // end if (limits.validate)
+
+    // Population storage is reserved up front, so the memory budget can be
+    // checked once, before anything is allocated. A bred generation may
+    // outgrow the first.
+    int room = max(popSize,
+                   settings.survivors(popSize) * (1 + settings.children));
+
+    if (limits.maxMemory > 0 &&
+        static_cast<long>(Population::footprint(room)) > limits.maxMemory)
+    {
+        result.status = BUDGET_EXHAUSTED;
+        return false;
+    } // end if (limits.maxMemory > 0)
+
+    current.reserve(room);
+
+    if (restored.population.empty())
+    {
+        populate(current);
+    }
+    else                            // continue where the checkpoint left off
+    {
+        current.assign(restored.population.begin(),
+                       restored.population.end());
+        result.generations = restored.generation;
+        result.evaluations = restored.evaluations;
+        restored.population.clear();
+
+        // The checkpoint keeps no lineages, so each restored Puzzle founds
+        // a line of its own, as a random one would.
+        for (size_t i = 0; i < current.size(); ++i)
+        {
+            current.setLineage(i, i + 1);
+        } // end for (size_t i = 0; i < current.size(); ++i)
+    } // end if (restored.population.empty())
+
+    if (checkpointEvery > 0)
+    {
+        writer = new CheckpointWriter(checkpointFile);
+    } // end if (checkpointEvery > 0)
+
+    PROFILE_GENERATION(0, 0);       // the first generation starts here
+
+    return true;
+} // end begin(SolveLimits&, Population&, SolveResult&)
+
+/** Run up to a given number of further generations of a run from begin().
+ * @param limits  The deadline and budgets for this run.
+ * @param current  The population of the run.
+ * @param result  The state of the run, which is updated.
+ * @param count  The most generations to run in this slice.
+ * @pre begin() returned true, and every advance() since returned true.
+ * @post current and result reflect the generations run.
+ * @return true if the run should be advanced again, false if it is over.
+ */
+bool GeneticAlgorithm::advance(const SolveLimits& limits, Population& current,
+                               SolveResult& result, int count)
+{
+    int stop = result.generations + min(count, maxGens - result.generations);
+
+    while (result.generations < stop)
+    {
+        // The writer only swaps buffers; the file is written on its thread.
+        // Every field is set each time, since the buffer handed back by the
+        // writer is a spare one.
+        if (writer != NULL && result.generations % checkpointEvery == 0)
+        {
+            snapshot.popSize = popSize;
+            snapshot.maxGens = maxGens;
+            snapshot.mutantiness = settings.mutantiness;
+            snapshot.survival = settings.survival;
+            snapshot.children = settings.children;
+            snapshot.preGen = preGen;
+            snapshot.generation = result.generations;
+            snapshot.evaluations = result.evaluations;
+            snapshot.rngState = rng.state();
+            snapshot.population.assign(current.begin(), current.end());
+            writer->submit(snapshot);
+        } // end if (writer != NULL)
+
+        // Only a first or restored generation can be over the budget here;
+        // breed() leaves no more children than the budget has room for.
+        if (limits.maxEvaluations > 0 &&
+            result.evaluations + static_cast<long>(current.size()) >
+            limits.maxEvaluations)
+        {
+            result.status = BUDGET_EXHAUSTED;
+            return false;
+        } // end if (limits.maxEvaluations > 0)
+
+        result.evaluations += current.size();
+        ++result.generations;
+
+        int best = current.deleteWorst(settings.survivors(popSize));
+
+        PROFILE_GENERATION(result.generations, best);
+        PROFILE_LANDSCAPE(current);
+
+        if (replay != NULL)
+        {
+            replay->note(result.generations, best, current);
+        } // end if (replay != NULL)
+
+        bool cancelled = listener != NULL && best > reported &&
+                         !report(current.front(), best, result.generations);
+
+        if (best == IDEAL)          // perfect fitness found
+        {
+            result.status = SOLVED;
+            return false;
+        } // end if (best == IDEAL)
+
+        if (cancelled)
+        {
+            result.status = CANCELLED;
+            return false;
+        } // end if (cancelled)
+
+        if (limits.hasDeadline && SolveLimits::Clock::now() >= limits.deadline)
+        {
+            result.status = TIMED_OUT;
+            return false;
+        } // end if (limits.hasDeadline)
+
+        // Selection came first, so a solution bred under the budget is kept.
+        // Each generation charges its survivors again, so one with no room
+        // for a child would only repeat this one.
+        long room = 0;                  // the most Puzzles, or 0 for any
+
+        if (limits.maxEvaluations > 0)
+        {
+            room = limits.maxEvaluations - result.evaluations;
+
+            if (room <= static_cast<long>(current.size()))
+            {
+                result.status = BUDGET_EXHAUSTED;
+                return false;
+            } // end if (room <= static_cast<long>(current.size()))
+        } // end if (limits.maxEvaluations > 0)
+
+        breed(current, room);
+    } // end while (result.generations < stop)
+
+    return result.generations < maxGens;
+} // end advance(SolveLimits&, Population&, SolveResult&, int)
+
+/** Finish a run from begin(), whether or not it was advanced to its end.
+ * @param current  The population of the run.
+ * @param result  The state of the run.
+ * @pre begin() was called with current and result.
+ * @post result.best holds the most fit Puzzle of the run, or the initial
+ *       puzzle if no population was made. Pending checkpoints are written.
+ */
+void GeneticAlgorithm::end(Population& current, SolveResult& result)
+{
+    result.best = current.empty() ? preGen : current.front();
+    result.cutoffs = current.cutoffCounts();
+    delete writer;                  // finishes any write still pending
+    writer = NULL;
+} // end end(Population&, SolveResult&)
+
+/** Assign an existing GeneticAlgorithm's settings to this object. A run in
+ *  progress is not copied.
+ * @param rhs  The GeneticAlgorithm with the values to be assigned.
+ * @pre No run is in progress on this object.
+ * @post This object is a duplicate of rhs. rhs is unchanged.
+ */
+void GeneticAlgorithm::operator=(const GeneticAlgorithm& rhs)
+{
+    popSize = rhs.popSize;
+    maxGens = rhs.maxGens;
+    settings = rhs.settings;
+    preGen = rhs.preGen;
+    rng = rhs.rng;
+    checkpointFile = rhs.checkpointFile;
+    checkpointEvery = rhs.checkpointEvery;
+    restored = rhs.restored;
+    replay = rhs.replay;
+    listener = rhs.listener;
+    prepare();
+} // end operator=(GeneticAlgorithm&)
+
+/** Restart the random sequence used by this algorithm.
+ * @param value  Any value; equal seeds give equal runs.
+ * @pre None.
+ * @post The next call to evolve() draws from a sequence fixed by value.
+ */
+void GeneticAlgorithm::seed(uint64_t value)
+{
+    rng = Random(value);
+} // end seed(uint64_t)
+
+/** Change how the search breeds and selects.
+ * @param chosen  The settings.
+ * @pre None.
+ * @post On success, the next run uses chosen.
+ * @return true if chosen is usable with the population size, false if not,
+ *         in which case nothing changes.
+ */
+bool GeneticAlgorithm::tune(const Tuning& chosen)
+{
+    if (!chosen.usable(popSize))
+    {
+        return false;
+    } // end if (!chosen.usable(popSize))
+
+    settings = chosen;
+
+    return true;
+} // end tune(Tuning&)
+
+/** Provide the settings of the search.
+ * @pre None.
+ * @post None.
+ * @return The settings.
+ */
+const Tuning& GeneticAlgorithm::tuning(void) const
+{
+    return settings;
+} // end tuning()
+
+/** Provide the size of the first generation.
+ * @pre None.
+ * @post None.
+ * @return The population size.
+ */
+int GeneticAlgorithm::populationSize(void) const
+{
+    return popSize;
+} // end populationSize()
+
+/** Record or check the selection made in every generation of evolve().
+ * @param log  An open log, or NULL to stop recording. The log is not owned and
+ *             must outlast the calls to evolve().
+ * @pre None.
+ * @post Subsequent calls to evolve() pass each generation to log.
+ */
+void GeneticAlgorithm::replayTo(ReplayLog *log)
+{
+    replay = log;
+} // end replayTo(ReplayLog*)
+
+/** Tell a listener of every improvement to the best Puzzle of a run.
+ * @param aListener  The listener, or NULL for none. It is not owned and must
+ *                   outlast the calls to evolve().
+ * @pre None.
+ * @post Subsequent runs pass each new best Puzzle to aListener, which may
+ *       cancel them.
+ */
+void GeneticAlgorithm::reportTo(ProgressListener *aListener)
+{
+    listener = aListener;
+} // end reportTo(ProgressListener*)
+
+/** Periodically save the state of evolve() so that it can be resumed.
+ *  Checkpoints are written in the background.
+ * @param path  The file to hold the newest checkpoint.
+ * @param every  Generations between checkpoints; 0 or less disables them.
+ * @pre None.
+ * @post Subsequent calls to evolve() write checkpoints to path.
+ */
+void GeneticAlgorithm::checkpointTo(const string& path, int every)
+{
+    checkpointFile = path;
+    checkpointEvery = every;
+} // end checkpointTo(string&, int)
+
+/** Load a checkpoint so that the next call to evolve() continues the run that
+ *  wrote it, instead of starting a new one.
+ * @param path  A file written by a run with checkpoints enabled.
+ * @pre None.
+ * @post On success, the puzzle, population size, generation limit, tuning
+ *       and random state are those of the saved run.
+ * @return true if the checkpoint was loaded, false otherwise.
+ */
+bool GeneticAlgorithm::restore(const string& path)
+{
+    Checkpoint loaded;
+    Tuning saved;
+
+    if (!loaded.load(path) || loaded.population.empty())
+    {
+        return false;
+    } // end if (!loaded.load(path) || loaded.population.empty())
+
+    saved.mutantiness = loaded.mutantiness;
+    saved.survival = loaded.survival;
+    saved.children = loaded.children;
+
+    if (!saved.usable(loaded.popSize))
+    {
+        return false;
+    } // end if (!saved.usable(loaded.popSize))
+
+    popSize = loaded.popSize;
+    maxGens = loaded.maxGens;
+    settings = saved;
+    preGen = loaded.preGen;
+    rng.setState(loaded.rngState);
+    restored = loaded;
+    prepare();
+
+    return true;
+} // end restore(string&)
+
+/** Continue from the population of an earlier run, for a puzzle that has since
+ *  gained clues, instead of starting from random Puzzles. Each Puzzle is
+ *  repaired to fit: the clues are put in place, and any free cell holding a
+ *  digit that a clue now rules out is drawn again. If there are fewer than the
+ *  population size, the rest are bred from the repaired ones as in any
+ *  generation.
+ * @param prior  The population, such as one left by evolve().
+ * @pre The random sequence is seeded as wanted; repairs draw from it.
+ * @post On success, the next run starts from the repaired population at
+ *       generation 0, with its full budgets.
+ * @return true if prior held any Puzzle, false otherwise.
+ */
+bool GeneticAlgorithm::warmStart(const Population& prior)
+{
+    if (prior.empty())
+    {
+        return false;
+    } // end if (prior.empty())
+
+    repair(vector<Puzzle>(prior.begin(), prior.end()));
+
+    return true;
+} // end warmStart(Population&)
+
+/** Continue from the population saved in a checkpoint, as above. The puzzle,
+ *  settings and random state of the saved run are ignored.
+ * @param path  A file written by a run with checkpoints enabled.
+ * @pre The random sequence is seeded as wanted; repairs draw from it.
+ * @post On success, the next run starts from the repaired population at
+ *       generation 0, with its full budgets.
+ * @return true if the checkpoint was loaded, false otherwise.
+ */
+bool GeneticAlgorithm::warmStart(const string& path)
+{
+    Checkpoint loaded;
+
+    if (!loaded.load(path) || loaded.population.empty())
+    {
+        return false;
+    } // end if (!loaded.load(path) || loaded.population.empty())
+
+    repair(loaded.population);
+
+    return true;
+} // end warmStart(string&)
 
 /** Generate the initial, random population of potential solutions.
  * @param pop  The population to fill with potential solutions.
  * @pre None.
- * @post pop contains popSize Puzzles with random attampts at solutions.
+ * @post pop contains popSize Puzzles with random attampts at solutions,
+ *       each founding its own lineage.
  */
 void GeneticAlgorithm::populate(Population& pop)
 {
     for (int i = 0; i < popSize; ++i)
     {
-        pop.push_back(mutate(preGen, 1.0));
+        char *child = pop.append();
+
+        preGen.write(child);
+        mutateCells(child, 1.0, rng);
+        pop.setLineage(pop.size() - 1, i + 1);  // each founds its own line
     } // end for (int i = 0)
 } // end populate()
 
-/** Completely fills a population that is only at 10% of its maximum size. The
- *  new elements are mutated from the original elements.
+/** Refills a population that holds only the survivors of selection. Each
+ *  survivor has settings.children children, mutated from it. Each is scored
+ *  as it is made, only far enough to cull it if it falls below every
+ *  survivor, and breeding stops early at one of perfect fitness or when the
+ *  population is as large as the evaluation budget allows.
  * @param pop  The population to refill.
- * @pre pop contains popSize / 10 elements.
- * @post pop contains popSize elements, 90% of which are derived from the
- *       initial 10%.
+ * @param room  The most Puzzles pop may hold, or 0 for no limit.
+ * @pre pop contains the survivors left by deleteWorst().
+ * @post pop contains the survivors and all of their children, each of its
+ *       parent's lineage, or ends with the first of IDEAL fitness or at
+ *       room Puzzles.
  */
-void GeneticAlgorithm::breed(Population& pop)
+void GeneticAlgorithm::breed(Population& pop, long room)
 {
-    Population::iterator parent = pop.begin();
+    int parents = pop.size();
+    int cutoff = pop.score(parents - 1);    // the worst survivor so far
 
-    for (int i = pop.size(); i > 0; --i, ++parent)
+    for (int i = 0; i < parents; ++i)
     {
-        for (int j = 0; j < 9; ++j)
+        for (int j = 0; j < settings.children; ++j)
         {
-            pop.push_back(mutate(*parent, MUTANTINESS));
-        } // end for (int j = 0)
-    } // end for (int i = 0)
-} // end breed(Population&)
+            if (room > 0 && static_cast<long>(pop.size()) >= room)
+            {
+                return;
+            } // end if (room > 0 && ...)
+
+            // Each child is copied from its parent straight into its slot.
+            char *child = pop.append();
+
+            memcpy(child, pop.genome(i), ROWS * COLUMNS);
+            mutateCells(child, settings.mutantiness, rng);
+            pop.setLineage(pop.size() - 1, pop.lineage(i));
+
+            // A child below every survivor cannot displace one of them, so
+            // its score is only taken far enough to show that.
+            if (pop.scoreNext(cutoff) == IDEAL)
+            {
+                return;
+            } // end if (pop.scoreNext(cutoff) == IDEAL)
+        } // end for (int j = 0; j < settings.children; ++j)
+    } // end for (int i = 0; i < parents; ++i)
+} // end breed(Population&, long)
 
 /** Mutate the elements of a single Puzzle. First, likelihood of mutation is
  *  checked. Then, if mutation occurs, a replacement is randomly selected. The
@@ -108,69 +647,204 @@ void GeneticAlgorithm::breed(Population& pop)
  */
 Puzzle GeneticAlgorithm::mutate(const Puzzle& parent, double chance) const
 {
-    Puzzle mutant = parent;
-    Puzzle::PuzzleIterator parIt = preGen.begin(), mutIt = mutant.begin();
+    return mutate(parent, chance, rng);
+} // end mutate(Puzzle&, double)
 
-    for (int i = 0; i < ROWS * COLUMNS; ++i, ++parIt, ++mutIt)
-    {
-        if (*parIt == '0')
-        {
-            if (chance >= 1.0)
-            {
-                mutant.setCell(mutIt, randDigit());
-            }
-            else if (chance > static_cast<double>(rand()) /
-                              static_cast<double>(RAND_MAX))
-            {
-                mutant.setCell(mutIt, randDigit());
-            } // end if (chance >= 1.0)
-        } // end if (*parIt == '0')
-    } // end for (int i = 0)
+/** Mutate a Puzzle as above, drawing from a given source of randomness, so
+ *  that several threads may mutate at once.
+ * @param parent  The Puzzle on which to base the mutation.
+ * @param chance  The likelihood of mutation, as above.
+ * @param source  The source of randomness, used by one thread only.
+ * @pre None.
+ * @post The parent Puzzle is unchanged.
+ * @return A Puzzle based on the input Puzzle, possibly identical.
+ */
+Puzzle GeneticAlgorithm::mutate(const Puzzle& parent, double chance,
+                                Random& source) const
+{
+    char cells[ROWS * COLUMNS];
+    Puzzle mutant;
+
+    parent.write(cells);
+    mutateCells(cells, chance, source);
+    mutant.read(cells);
 
     return mutant;
-} // end mutate(double)
+} // end mutate(Puzzle&, double, Random&)
 
-/** Select a digit from 1 to 9 at random.
- * @pre srand() has already been called.
- * @post None.
- * @return The char for an ASCII digit in the range 1-9, inclusive.
+/** Mutate the cells of a child of preGen in place. The free cells are visited
+ *  from freeList, and random numbers are drawn in the same order as by
+ *  mutate().
+ * @param cells  ROWS * COLUMNS chars holding the parent's cells.
+ * @param chance  The likelihood of mutation, as for mutate().
+ * @param source  The source of randomness, used by one thread only.
+ * @pre The clues of preGen are in place in cells.
+ * @post cells hold the child.
  */
-char GeneticAlgorithm::randDigit(void) const
+void GeneticAlgorithm::mutateCells(char *cells, double chance,
+                                   Random& source) const
 {
-    double range = (floor((static_cast<double>(rand()) /
-                           static_cast<double>(RAND_MAX)) * 9.0));
-    if (range < 1.0)
-    {
-        return '1';
-    }
-    else if (range < 2.0)
+    PROFILE_SCOPE(PROFILE_MUTATE);
+
+    if (chance >= 1.0)
     {
-        return '2';
-    }
-    else if (range < 3.0)
+        for (int i = 0; i < freeCount; ++i)
+        {
+            cells[freeList[i]] = randDigit(freeList[i], source);
+        } // end for (int i = 0; i < freeCount; ++i)
+
+        return;
+    } // end if (chance >= 1.0)
+
+    // uniform() is (next() >> 11) / 2^53, so chance > uniform() exactly when
+    // next() >> 11 is below chance * 2^53, rounded up; comparing integers
+    // saves a conversion for every cell.
+    uint64_t threshold = static_cast<uint64_t>(
+        ceil(chance * 9007199254740992.0));
+
+    for (int i = 0; i < freeCount; ++i)
     {
-        return '3';
-    }
-    else if (range < 4.0)
+        if ((source.next() >> 11) < threshold)
+        {
+            cells[freeList[i]] = randDigit(freeList[i], source);
+        } // end if ((source.next() >> 11) < threshold)
+    } // end for (int i = 0; i < freeCount; ++i)
+} // end mutateCells(char*, double, Random&)
+
+/** Find the cells that preGen leaves empty and the digits its clues leave
+ *  open in each, and build the evaluator for its children.
+ * @pre None.
+ * @post freeList, candidates, options and evaluator describe preGen.
+ */
+void GeneticAlgorithm::prepare(void)
+{
+    char cells[ROWS * COLUMNS];
+    int rowUsed[ROWS] = { 0 }, columnUsed[COLUMNS] = { 0 };
+    int nonetUsed[ROWS] = { 0 };
+
+    preGen.write(cells);
+    evaluator = FitnessEvaluator(preGen);
+    freeCount = 0;
+
+    for (int i = 0; i < ROWS * COLUMNS; ++i)
     {
-        return '4';
-    }
-    else if (range < 5.0)
+        if (cells[i] != '0')
+        {
+            int bit = 1 << (cells[i] - '0');
+
+            rowUsed[i / COLUMNS] |= bit;
+            columnUsed[i % COLUMNS] |= bit;
+            nonetUsed[(i / COLUMNS) / 3 * 3 + (i % COLUMNS) / 3] |= bit;
+        }
+        else
+        {
+            freeList[freeCount++] = i;
+        } // end if (cells[i] != '0')
+    } // end for (int i = 0; i < ROWS * COLUMNS; ++i)
+
+    for (int i = 0; i < ROWS * COLUMNS; ++i)
     {
-        return '5';
-    }
-    else if (range < 6.0)
+        int used = rowUsed[i / COLUMNS] | columnUsed[i % COLUMNS] |
+                   nonetUsed[(i / COLUMNS) / 3 * 3 + (i % COLUMNS) / 3];
+
+        options[i] = 0;
+
+        for (int digit = 1; digit <= 9; ++digit)
+        {
+            if (!(used & (1 << digit)))
+            {
+                candidates[i][options[i]++] = '0' + digit;
+            } // end if (!(used & (1 << digit)))
+        } // end for (int digit = 1; digit <= 9; ++digit)
+
+        // Clues that leave a cell nothing cannot be satisfied anyway; let it
+        // take any digit rather than none.
+        if (options[i] == 0)
+        {
+            for (int digit = 1; digit <= 9; ++digit)
+            {
+                candidates[i][options[i]++] = '0' + digit;
+            } // end for (int digit = 1; digit <= 9; ++digit)
+        } // end if (options[i] == 0)
+    } // end for (int i = 0; i < ROWS * COLUMNS; ++i)
+} // end prepare()
+
+/** Pass the best Puzzle of a generation to the listener if it is better than
+ *  any passed before in this run.
+ * @param best  The best Puzzle.
+ * @param fitness  Its fitness.
+ * @param generation  The number of the generation.
+ * @pre listener is not NULL.
+ * @post None.
+ * @return false if the listener asked to stop, true otherwise.
+ */
+bool GeneticAlgorithm::report(const Puzzle& best, int fitness, int generation)
+{
+    if (fitness <= reported)
     {
-        return '6';
-    }
-    else if (range < 7.0)
+        return true;
+    } // end if (fitness <= reported)
+
+    reported = fitness;
+
+    return listener->improved(best, fitness, generation);
+} // end report(Puzzle&, int, int)
+
+/** Repair Puzzles of an earlier run to fit preGen, and fill out a population
+ *  from them, to be taken up by the next begin().
+ * @param prior  The Puzzles, best first.
+ * @pre prior is not empty.
+ * @post restored holds popSize children of preGen at generation 0.
+ */
+void GeneticAlgorithm::repair(const vector<Puzzle>& prior)
+{
+    char clues[ROWS * COLUMNS], cells[ROWS * COLUMNS];
+    size_t kept = min(prior.size(), static_cast<size_t>(popSize));
+
+    preGen.write(clues);
+    restored.generation = 0;
+    restored.evaluations = 0;
+    restored.population.resize(popSize);
+
+    for (size_t i = 0; i < kept; ++i)
     {
-        return '7';
-    }
-    else if (range < 8.0)
+        prior[i].write(cells);
+
+        for (int cell = 0; cell < ROWS * COLUMNS; ++cell)
+        {
+            if (clues[cell] != '0')
+            {
+                cells[cell] = clues[cell];
+            }
+            else if (memchr(candidates[cell], cells[cell],
+                            options[cell]) == NULL)
+            {
+                cells[cell] = randDigit(cell, rng);  // empty or ruled out
+            } // end if (clues[cell] != '0')
+        } // end for (int cell = 0; cell < ROWS * COLUMNS; ++cell)
+
+        restored.population[i].read(cells);
+    } // end for (size_t i = 0; i < kept; ++i)
+
+    // A converged run leaves only its survivors; their children make up the
+    // rest, taking each in turn, as breed() would make them.
+    for (size_t i = kept; i < restored.population.size(); ++i)
     {
-        return '8';
-    }
+        restored.population[(i - kept) % kept].write(cells);
+        mutateCells(cells, settings.mutantiness, rng);
+        restored.population[i].read(cells);
+    } // end for (size_t i = kept; i < restored.population.size(); ++i)
+} // end repair(vector<Puzzle>&)
 
-    return '9';
-} // end randDigit()
+/** Select a digit at random from those no clue rules out for a cell. A digit
+ *  already given in the cell's row, column or nonet could only cost fitness.
+ * @param cell  The index of the cell.
+ * @param source  The source of randomness.
+ * @pre The cell is empty in preGen.
+ * @post None.
+ * @return The char for an ASCII digit in the range 1-9, inclusive.
+ */
+char GeneticAlgorithm::randDigit(int cell, Random& source) const
+{
+    return candidates[cell][source.below(options[cell])];
+} // end randDigit(int, Random&)
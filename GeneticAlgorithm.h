@@ -9,19 +9,143 @@
 #ifndef _GENETICALGORITHM_H
 #define	_GENETICALGORITHM_H
 
+#include <chrono>
 #include <cmath>
 #include <cstdlib>
+#include <string>
 
+#include "Checkpoint.h"
 #include "Population.h"
+#include "Random.h"
+#include "ReplayLog.h"
+#include "SolutionCounter.h"
 
 const int IDEAL = ROWS * COLUMNS;
-const double MUTANTINESS = 0.05;
+const double MUTANTINESS = 0.05;    // default chance a child's cell changes
+const double SURVIVAL = 0.1;        // default share of a generation kept
+const int CHILDREN = 9;             // default children bred per survivor
+
+
+/** Reasons for which a call to evolve() may stop.
+ */
+enum SolveStatus
+{
+    SOLVED,                 // a Puzzle with IDEAL fitness was found
+    GENERATIONS_EXHAUSTED,  // maxGens generations ran without a solution
+    TIMED_OUT,              // the deadline passed before a solution was found
+    BUDGET_EXHAUSTED,       // the evaluation or memory budget ran out
+    REJECTED,               // the puzzle failed validation; nothing was run
+    CANCELLED               // a ProgressListener asked the run to stop
+};
+
+
+/** Hard bounds on a single call to evolve(). A limit that is left at its
+ *  default does not constrain the run.
+ */
+struct SolveLimits
+{
+    typedef std::chrono::steady_clock Clock;
+
+    /** Default constructor. No deadline, no budgets and no validation.
+     */
+    SolveLimits();
+
+    /** Build limits that expire a given number of seconds from now.
+     * @param seconds  Wall-clock time allowed from the moment of the call.
+     * @pre None.
+     * @post None.
+     * @return Limits with only the deadline set.
+     */
+    static SolveLimits within(double seconds);
+
+    bool hasDeadline;       // whether deadline is to be checked
+    Clock::time_point deadline;
+    long maxEvaluations;    // fitness evaluations allowed; 0 for unlimited
+    long maxMemory;         // bytes of Population storage; 0 for unlimited
+    bool validate;          // reject puzzles without exactly one solution
+};
+
+
+/** How the search breeds and selects: the settings that do not change what
+ *  is being solved, only how quickly a solution is found.
+ */
+struct Tuning
+{
+    /** Default constructor. MUTANTINESS, SURVIVAL and CHILDREN.
+     */
+    Tuning();
+
+    /** Find how many Puzzles survive each selection.
+     * @param popSize  The size of the first generation.
+     * @pre None.
+     * @post None.
+     * @return survival of popSize, rounded down.
+     */
+    int survivors(int popSize) const;
+
+    /** Check that these settings can run with a population size.
+     * @param popSize  The size of the first generation.
+     * @pre None.
+     * @post None.
+     * @return true if mutantiness is in (0, 1], at least one Puzzle survives
+     *         and one is culled, and every survivor has a child; false
+     *         otherwise.
+     */
+    bool usable(int popSize) const;
+
+    double mutantiness;     // chance that each free cell of a child changes
+    double survival;        // share of the first generation kept each time
+    int children;           // children bred from each survivor
+};
+
+
+/** The outcome of a bounded call to evolve().
+ */
+struct SolveResult
+{
+    Puzzle best;            // most fit Puzzle seen when the run stopped
+    SolveStatus status;     // why the run stopped
+    int generations;        // number of generations that were selected
+    long evaluations;       // number of Puzzles that were scored
+    Validity validity;      // verdict of validation, UNIQUE if not checked
+    CutoffCounters cutoffs; // scoring work saved by culling children early
+};
+
+
+/** Hears of every improvement to the best Puzzle of a run as it happens, so
+ *  that a caller can show partial results, or stop the run by rules of its
+ *  own.
+ */
+class ProgressListener
+{
+public:
+
+    /** Destructor.
+     */
+    virtual ~ProgressListener();
+
+    /** Hear of a new best Puzzle. Called on the thread running the search,
+     *  and only when the best fitness has risen, so a run that has stalled
+     *  costs nothing.
+     * @param best  The most fit Puzzle so far.
+     * @param fitness  Its fitness; IDEAL for a solution, which ends the run.
+     * @param generation  The number of the generation that found it.
+     * @pre None.
+     * @post None.
+     * @return true to let the run go on, false to stop it as CANCELLED.
+     */
+    virtual bool improved(const Puzzle& best, int fitness, int generation) = 0;
+
+};
 
 
 class GeneticAlgorithm
 {
 public:
 
+    friend class Islands;
+    friend class Pipeline;
+
     /** Default constructor.
      */
     GeneticAlgorithm();
@@ -41,6 +165,14 @@ public:
     /** Destructor.
      */
     virtual ~GeneticAlgorithm();
+
+    /** Assign an existing GeneticAlgorithm's settings to this object. A run
+     *  in progress is not copied.
+     * @param rhs  The GeneticAlgorithm with the values to be assigned.
+     * @pre No run is in progress on this object.
+     * @post This object is a duplicate of rhs. rhs is unchanged.
+     */
+    void operator=(const GeneticAlgorithm& rhs);
     
     /** Attempt to evolve a solution to a Sudoku puzzle. Stops if a true
      *  solution is found.
@@ -51,27 +183,225 @@ public:
      */
     Puzzle evolve(void);
 
+    /** Attempt to evolve a solution to a Sudoku puzzle without exceeding the
+     *  given limits. Limits are checked once per generation.
+     * @param limits  The deadline and budgets for this run.
+     * @pre None.
+     * @post None.
+     * @return The most fit solution found before a limit was hit, along with
+     *         the reason the run stopped.
+     */
+    SolveResult evolve(const SolveLimits& limits);
+
+    /** Attempt to evolve a solution as above, keeping the population in
+     *  storage supplied by the caller. Reusing one workspace across many
+     *  calls avoids allocating a population for every puzzle.
+     * @param limits  The deadline and budgets for this run.
+     * @param current  Storage for the population; its contents are
+     *                 discarded, but its capacity is kept.
+     * @pre None.
+     * @post current holds the final population.
+     * @return The most fit solution found before a limit was hit, along with
+     *         the reason the run stopped.
+     */
+    SolveResult evolve(const SolveLimits& limits, Population& current);
+
+    /** Start a run that is to be advanced a slice of generations at a time,
+     *  so that a scheduler can interleave it with other work.
+     * @param limits  The deadline and budgets for this run.
+     * @param current  Storage for the population; its contents are
+     *                 discarded, but its capacity is kept.
+     * @param result  Set to the state of the run.
+     * @pre None.
+     * @post current holds the initial population, each Puzzle founding its
+     *       own lineage, unless the run is already over.
+     * @return true if the run should be advanced, false if it is already
+     *         over; end() must be called either way.
+     */
+    bool begin(const SolveLimits& limits, Population& current,
+               SolveResult& result);
+
+    /** Run up to a given number of further generations of a run from
+     *  begin().
+     * @param limits  The deadline and budgets for this run.
+     * @param current  The population of the run.
+     * @param result  The state of the run, which is updated.
+     * @param count  The most generations to run in this slice.
+     * @pre begin() returned true, and every advance() since returned true.
+     * @post current and result reflect the generations run.
+     * @return true if the run should be advanced again, false if it is over.
+     */
+    bool advance(const SolveLimits& limits, Population& current,
+                 SolveResult& result, int count);
+
+    /** Finish a run from begin(), whether or not it was advanced to its end.
+     * @param current  The population of the run.
+     * @param result  The state of the run.
+     * @pre begin() was called with current and result.
+     * @post result.best holds the most fit Puzzle of the run, or the initial
+     *       puzzle if no population was made. Pending checkpoints are
+     *       written.
+     */
+    void end(Population& current, SolveResult& result);
+
+    /** Restart the random sequence used by this algorithm.
+     * @param value  Any value; equal seeds give equal runs.
+     * @pre None.
+     * @post The next call to evolve() draws from a sequence fixed by value.
+     */
+    void seed(uint64_t value);
+
+    /** Change how the search breeds and selects.
+     * @param chosen  The settings.
+     * @pre None.
+     * @post On success, the next run uses chosen.
+     * @return true if chosen is usable with the population size, false if
+     *         not, in which case nothing changes.
+     */
+    bool tune(const Tuning& chosen);
+
+    /** Provide the settings of the search.
+     * @pre None.
+     * @post None.
+     * @return The settings.
+     */
+    const Tuning& tuning(void) const;
+
+    /** Provide the size of the first generation.
+     * @pre None.
+     * @post None.
+     * @return The population size.
+     */
+    int populationSize(void) const;
+
+    /** Record or check the selection made in every generation of evolve().
+     * @param log  An open log, or NULL to stop recording. The log is not
+     *             owned and must outlast the calls to evolve().
+     * @pre None.
+     * @post Subsequent calls to evolve() pass each generation to log.
+     */
+    void replayTo(ReplayLog *log);
+
+    /** Tell a listener of every improvement to the best Puzzle of a run.
+     * @param aListener  The listener, or NULL for none. It is not owned and
+     *                   must outlast the calls to evolve().
+     * @pre None.
+     * @post Subsequent runs pass each new best Puzzle to aListener, which
+     *       may cancel them.
+     */
+    void reportTo(ProgressListener *aListener);
+
+    /** Periodically save the state of evolve() so that it can be resumed.
+     *  Checkpoints are written in the background.
+     * @param path  The file to hold the newest checkpoint.
+     * @param every  Generations between checkpoints; 0 or less disables them.
+     * @pre None.
+     * @post Subsequent calls to evolve() write checkpoints to path.
+     */
+    void checkpointTo(const string& path, int every);
+
+    /** Load a checkpoint so that the next call to evolve() continues the run
+     *  that wrote it, instead of starting a new one.
+     * @param path  A file written by a run with checkpoints enabled.
+     * @pre None.
+     * @post On success, the puzzle, population size, generation limit,
+     *       tuning and random state are those of the saved run.
+     * @return true if the checkpoint was loaded, false otherwise.
+     */
+    bool restore(const string& path);
+
+    /** Continue from the population of an earlier run, for a puzzle that has
+     *  since gained clues, instead of starting from random Puzzles. Each
+     *  Puzzle is repaired to fit: the clues are put in place, and any free
+     *  cell holding a digit that a clue now rules out is drawn again. If
+     *  there are fewer than the population size, the rest are bred from the
+     *  repaired ones as in any generation.
+     * @param prior  The population, such as one left by evolve().
+     * @pre The random sequence is seeded as wanted; repairs draw from it.
+     * @post On success, the next run starts from the repaired population at
+     *       generation 0, with its full budgets.
+     * @return true if prior held any Puzzle, false otherwise.
+     */
+    bool warmStart(const Population& prior);
+
+    /** Continue from the population saved in a checkpoint, as above. The
+     *  puzzle, settings and random state of the saved run are ignored.
+     * @param path  A file written by a run with checkpoints enabled.
+     * @pre The random sequence is seeded as wanted; repairs draw from it.
+     * @post On success, the next run starts from the repaired population at
+     *       generation 0, with its full budgets.
+     * @return true if the checkpoint was loaded, false otherwise.
+     */
+    bool warmStart(const string& path);
+
 private:
 
     int popSize;
     int maxGens;
+    Tuning settings;
     Puzzle preGen;
+    mutable Random rng;
+    string checkpointFile;
+    int checkpointEvery;
+    Checkpoint restored;        // population is empty unless resuming
+    ReplayLog *replay;
+    ProgressListener *listener;
+    int reported;               // best fitness passed to listener this run
+    CheckpointWriter *writer;   // only while a run is in progress
+    Checkpoint snapshot;        // reused buffer for the writer
+    char candidates[ROWS * COLUMNS][9]; // digits no clue rules out, by cell
+    int options[ROWS * COLUMNS];        // how many candidates each cell has
+    int freeList[ROWS * COLUMNS];       // cells preGen leaves empty, in order
+    int freeCount;
+    FitnessEvaluator evaluator;         // scores children of preGen
+
+    /** Find the cells that preGen leaves empty and the digits its clues leave
+     *  open in each, and build the evaluator for its children.
+     * @pre None.
+     * @post freeList, candidates, options and evaluator describe preGen.
+     */
+    void prepare(void);
+
+    /** Pass the best Puzzle of a generation to the listener if it is better
+     *  than any passed before in this run.
+     * @param best  The best Puzzle.
+     * @param fitness  Its fitness.
+     * @param generation  The number of the generation.
+     * @pre listener is not NULL.
+     * @post None.
+     * @return false if the listener asked to stop, true otherwise.
+     */
+    bool report(const Puzzle& best, int fitness, int generation);
+
+    /** Repair Puzzles of an earlier run to fit preGen, and fill out a
+     *  population from them, to be taken up by the next begin().
+     * @param prior  The Puzzles, best first.
+     * @pre prior is not empty.
+     * @post restored holds popSize children of preGen at generation 0.
+     */
+    void repair(const vector<Puzzle>& prior);
 
     /** Generate the initial, random population of potential solutions.
      * @param pop  The population to fill with potential solutions.
      * @pre None.
-     * @post pop contains popSize Puzzles with random attampts at solutions.
+     * @post pop contains popSize Puzzles with random attampts at solutions,
+     *       each founding its own lineage.
      */
     void populate(Population& pop);
 
-    /** Completely fills a population that is only at 10% of its maximum size.
-     *  The new elements are mutated from the original elements.
+    /** Refills a population that holds only the survivors of selection.
+     *  Each survivor has settings.children children, mutated from it. Each
+     *  is scored as it is made, only far enough to cull it if it falls below
+     *  every survivor, and breeding stops early at one of perfect fitness or
+     *  when the population is as large as the evaluation budget allows.
      * @param pop  The population to refill.
-     * @pre pop contains popSize / 10 elements.
-     * @post pop contains popSize elements, 90% of which are derived from the
-     *       initial 10%.
+     * @param room  The most Puzzles pop may hold, or 0 for no limit.
+     * @pre pop contains the survivors left by deleteWorst().
+     * @post pop contains the survivors and all of their children, each of
+     *       its parent's lineage, or ends with the first of IDEAL fitness or
+     *       at room Puzzles.
      */
-    void breed(Population& pop);
+    void breed(Population& pop, long room);
 
     /** Mutate the elements of a single Puzzle. First, likelihood of mutation
      *  is checked. Then, if mutation occurs, a replacement is randomly
@@ -86,12 +416,36 @@ private:
      */
     Puzzle mutate(const Puzzle& parent, double chance) const;
 
-    /** Select a digit from 1 to 9 at random.
-     * @pre srand() has already been called.
+    /** Mutate a Puzzle as above, drawing from a given source of randomness,
+     *  so that several threads may mutate at once.
+     * @param parent  The Puzzle on which to base the mutation.
+     * @param chance  The likelihood of mutation, as above.
+     * @param source  The source of randomness, used by one thread only.
+     * @pre None.
+     * @post The parent Puzzle is unchanged.
+     * @return A Puzzle based on the input Puzzle, possibly identical.
+     */
+    Puzzle mutate(const Puzzle& parent, double chance, Random& source) const;
+
+    /** Mutate the cells of a child of preGen in place. The free cells are
+     *  visited from freeList, and random numbers are drawn in the same order
+     *  as by mutate().
+     * @param cells  ROWS * COLUMNS chars holding the parent's cells.
+     * @param chance  The likelihood of mutation, as for mutate().
+     * @param source  The source of randomness, used by one thread only.
+     * @pre The clues of preGen are in place in cells.
+     * @post cells hold the child.
+     */
+    void mutateCells(char *cells, double chance, Random& source) const;
+
+    /** Select a digit at random from those no clue rules out for a cell.
+     * @param cell  The index of the cell.
+     * @param source  The source of randomness.
+     * @pre The cell is empty in preGen.
      * @post None.
      * @return The char for an ASCII digit in the range 1-9, inclusive.
      */
-    char randDigit(void) const;
+    char randDigit(int cell, Random& source) const;
 
 };
 
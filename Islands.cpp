@@ -0,0 +1,415 @@
+/**
+ * @file    Islands.cpp
+ * @brief   Solve one puzzle in several processes at once. Each island is a
+ *          forked process with a population and heap of its own, so a crash
+ *          loses one island rather than the run. Every few generations an
+ *          island sends its best Puzzle to the next island around a ring,
+ *          and adopts the best posted by any island if that beats its own.
+ *          The islands meet only in a block of shared memory that holds one
+ *          lock-free ring of migrants and one posted best per island; the
+ *          calling process collects the best of them, reports progress and
+ *          tells the islands to stop once one has solved the puzzle. Runs
+ *          are not repeatable, since migrants arrive whenever the islands
+ *          happen to send them.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Islands.h"
+
+// Atomics shared between processes must not fall back on a lock, which
+// would live in one process's memory only.
+#if ATOMIC_INT_LOCK_FREE != 2
+#error "Islands needs lock-free atomic ints."
+#endif
+
+static const int MOST_ISLANDS = 64;
+static const uint32_t RING_SLOTS = 8;   // migrants in flight to one island
+
+
+/** Migrants on their way to one island. Only the island before it writes,
+ *  and only the island itself reads, so neither needs a lock; a migrant sent
+ *  to a full ring is dropped.
+ */
+struct alignas(64) Ring
+{
+    atomic<uint32_t> head;              // migrants sent
+    atomic<uint32_t> tail;              // migrants received
+    unsigned char slots[RING_SLOTS][PACKED_SIZE];
+};
+
+/** The best Puzzle of one island, and its outcome once it has finished.
+ *  Only the island writes it. Readers copy the best and retry if version
+ *  changed meanwhile; version is odd while a write is in progress, and 0
+ *  until the first.
+ */
+struct alignas(64) Post
+{
+    atomic<uint32_t> version;
+    atomic<int> fitness;
+    atomic<int> generation;
+    unsigned char best[PACKED_SIZE];
+    atomic<int> finished;               // nonzero once the fields below are
+    int status;
+    int generations;
+    long evaluations;
+    int validity;
+};
+
+/** Everything the islands share.
+ */
+struct Islands::Shared
+{
+    atomic<int> stop;                   // nonzero once the islands should end
+    Post posts[MOST_ISLANDS];
+    Ring rings[MOST_ISLANDS];           // rings[i] is bound for island i
+};
+
+
+/** Post an island's best Puzzle.
+ * @param mine  The island's post.
+ * @param best  Its best Puzzle.
+ * @param fitness  The fitness of best.
+ * @param generation  The generation that found it.
+ * @pre Only the island owning mine calls this.
+ * @post Readers see best once the call returns.
+ */
+static void post(Post& mine, const Puzzle& best, int fitness, int generation)
+{
+    uint32_t version = mine.version.load(memory_order_relaxed);
+
+    mine.version.store(version + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    best.pack(mine.best);
+    mine.fitness.store(fitness, memory_order_relaxed);
+    mine.generation.store(generation, memory_order_relaxed);
+    mine.version.store(version + 2, memory_order_release);
+} // end post(Post&, Puzzle&, int, int)
+
+/** Read the best Puzzle an island has posted.
+ * @param theirs  The island's post.
+ * @param best  Set to the Puzzle on success.
+ * @param fitness  Set to its fitness on success.
+ * @param generation  Set to the generation that found it on success.
+ * @pre None.
+ * @post None.
+ * @return true if a whole Puzzle was read, false if none has been posted or
+ *         the island kept changing it.
+ */
+static bool read(const Post& theirs, Puzzle& best, int& fitness,
+                 int& generation)
+{
+    unsigned char copy[PACKED_SIZE];
+
+    for (int tries = 0; tries < 4; ++tries)
+    {
+        uint32_t before = theirs.version.load(memory_order_acquire);
+
+        if (before % 2 != 0)
+        {
+            continue;
+        } // end if (before % 2 != 0)
+
+        memcpy(copy, theirs.best, PACKED_SIZE);
+        fitness = theirs.fitness.load(memory_order_relaxed);
+        generation = theirs.generation.load(memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+
+        if (theirs.version.load(memory_order_relaxed) == before)
+        {
+            return before != 0 && best.unpack(copy);
+        } // end if (theirs.version.load(memory_order_relaxed) == before)
+    } // end for (int tries = 0; tries < 4; ++tries)
+
+    return false;
+} // end read(Post&, Puzzle&, int&, int&)
+
+/** Send a migrant to the island a ring is bound for.
+ * @param ring  The ring.
+ * @param migrant  The Puzzle to send.
+ * @pre Only the island before the ring's island calls this.
+ * @post The migrant is in the ring, unless the ring was full.
+ */
+static void send(Ring& ring, const Puzzle& migrant)
+{
+    uint32_t head = ring.head.load(memory_order_relaxed);
+
+    if (head - ring.tail.load(memory_order_acquire) < RING_SLOTS)
+    {
+        migrant.pack(ring.slots[head % RING_SLOTS]);
+        ring.head.store(head + 1, memory_order_release);
+    } // end if (head - ring.tail.load(memory_order_acquire) < RING_SLOTS)
+} // end send(Ring&, Puzzle&)
+
+/** Take the oldest migrant from a ring.
+ * @param ring  The ring.
+ * @param migrant  Set to the migrant on success.
+ * @pre Only the ring's island calls this.
+ * @post The migrant, if any, has left the ring.
+ * @return true if a migrant was taken, false if the ring was empty.
+ */
+static bool receive(Ring& ring, Puzzle& migrant)
+{
+    uint32_t tail = ring.tail.load(memory_order_relaxed);
+
+    if (tail == ring.head.load(memory_order_acquire))
+    {
+        return false;
+    } // end if (tail == ring.head.load(memory_order_acquire))
+
+    bool good = migrant.unpack(ring.slots[tail % RING_SLOTS]);
+
+    ring.tail.store(tail + 1, memory_order_release);
+
+    return good;
+} // end receive(Ring&, Puzzle&)
+
+
+/** Constructor.
+ * @param engine  The algorithm, with its puzzle, sizes and seed. It must not
+ *                checkpoint or replay; each island is seeded from it.
+ * @param count  The number of island processes, at least 1.
+ * @param interval  Generations between migrations, at least 1.
+ */
+Islands::Islands(const GeneticAlgorithm& engine, int count, int interval) :
+    engine(engine), count(min(max(1, count), MOST_ISLANDS)),
+    interval(max(1, interval)), casualties(0)
+{
+} // end constructor
+
+/** Destructor.
+ */
+Islands::~Islands()
+{
+} // end destructor
+
+/** Evolve a solution without exceeding the given limits, which apply to each
+ *  island. The generations reported are those of the island with the best
+ *  Puzzle; the evaluations are those of every island.
+ * @param limits  The deadline and budgets for this run.
+ * @pre No other call to run() is in progress.
+ * @post None.
+ * @return The most fit solution found by any island, along with the reason
+ *         its island stopped. If no island finished, the status is
+ *         BUDGET_EXHAUSTED and the best is the puzzle itself.
+ */
+SolveResult Islands::run(const SolveLimits& limits)
+{
+    SolveResult result;
+    vector<pid_t> crew(count, -1);
+    int found = -1;
+    void *block = mmap(NULL, sizeof(Shared), PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+    result.best = engine.preGen;
+    result.status = BUDGET_EXHAUSTED;
+    result.generations = 0;
+    result.evaluations = 0;
+    result.validity = UNIQUE;
+    casualties = 0;
+    engine.reported = CULLED;
+
+    if (block == MAP_FAILED)
+    {
+        return result;
+    } // end if (block == MAP_FAILED)
+
+    // The mapping is zeroed, which is the state every member starts in.
+    Shared *shared = new (block) Shared;
+
+    // Output still buffered would otherwise be written again by each island.
+    cout.flush();
+    cerr.flush();
+    fflush(NULL);
+
+    for (int i = 0; i < count; ++i)
+    {
+        uint64_t seed = engine.rng.next();
+
+        crew[i] = fork();
+
+        if (crew[i] == 0)
+        {
+            voyage(i, seed, limits, shared);
+            _exit(0);
+        } // end if (crew[i] == 0)
+    } // end for (int i = 0; i < count; ++i)
+
+    // Watch the posts for new bests until every island has ended.
+    for (int left = count; left > 0; )
+    {
+        Puzzle best;
+        int fitness = CULLED, generation = 0;
+
+        left = 0;
+
+        for (int i = 0; i < count; ++i)
+        {
+            if (crew[i] > 0 && waitpid(crew[i], NULL, WNOHANG) == 0)
+            {
+                ++left;
+            } // end if (crew[i] > 0 && waitpid(crew[i], NULL, WNOHANG) == 0)
+        } // end for (int i = 0; i < count; ++i)
+
+        for (int i = 0; i < count && engine.listener != NULL; ++i)
+        {
+            Puzzle theirs;
+            int score, when;
+
+            if (read(shared->posts[i], theirs, score, when) &&
+                score > fitness)
+            {
+                best = theirs;
+                fitness = score;
+                generation = when;
+            } // end if (read(shared->posts[i], theirs, score, when) && ...)
+        } // end for (int i = 0; i < count && engine.listener != NULL; ++i)
+
+        if (engine.listener != NULL && fitness > engine.reported &&
+            !engine.report(best, fitness, generation))
+        {
+            shared->stop.store(1);
+        } // end if (engine.listener != NULL && ...)
+
+        if (left > 0)
+        {
+            this_thread::sleep_for(chrono::milliseconds(1));
+        } // end if (left > 0)
+    } // end for (int left = count; left > 0; )
+
+    // An island that ended without finishing has crashed or been killed.
+    for (int i = 0; i < count; ++i)
+    {
+        const Post& theirs = shared->posts[i];
+
+        if (crew[i] <= 0 || theirs.finished.load() == 0)
+        {
+            ++casualties;
+            continue;
+        } // end if (crew[i] <= 0 || theirs.finished.load() == 0)
+
+        result.evaluations += theirs.evaluations;
+
+        if (found < 0 ||
+            theirs.fitness.load() > shared->posts[found].fitness.load())
+        {
+            found = i;
+        } // end if (found < 0 || ...)
+    } // end for (int i = 0; i < count; ++i)
+
+    if (found >= 0)
+    {
+        const Post& winner = shared->posts[found];
+        int fitness, generation;
+
+        read(winner, result.best, fitness, generation);
+        result.status = static_cast<SolveStatus>(winner.status);
+        result.generations = winner.generations;
+        result.validity = static_cast<Validity>(winner.validity);
+    } // end if (found >= 0)
+
+    shared->~Shared();
+    munmap(block, sizeof(Shared));
+
+    return result;
+} // end run(SolveLimits&)
+
+/** Provide the number of islands lost in the last run, whose process ended
+ *  without finishing its run.
+ * @pre None.
+ * @post None.
+ * @return The count of islands lost.
+ */
+int Islands::lost(void) const
+{
+    return casualties;
+} // end lost()
+
+/** Run one island to its end, in its own process.
+ * @param index  Which island.
+ * @param seed  Seeds the island's algorithm.
+ * @param limits  The deadline and budgets for the island.
+ * @param shared  The block shared by every island.
+ * @pre shared is mapped and initialized.
+ * @post The island's outcome is posted in shared.
+ */
+void Islands::voyage(int index, uint64_t seed, const SolveLimits& limits,
+                     Shared *shared)
+{
+    GeneticAlgorithm island(engine);
+    Population current;
+    SolveResult result;
+    Post& mine = shared->posts[index];
+    Ring& inbox = shared->rings[index];
+    Ring& outbox = shared->rings[(index + 1) % count];
+    size_t survivors = engine.settings.survivors(engine.popSize);
+
+    island.seed(seed);
+    island.reportTo(NULL);          // progress is reported by the caller
+
+    bool more = island.begin(limits, current, result);
+
+    while (more && island.advance(limits, current, result, interval))
+    {
+        Puzzle migrant;
+        int fitness, generation, best = current.score(0);
+
+        if (shared->stop.load() != 0)
+        {
+            result.status = CANCELLED;
+            break;
+        } // end if (shared->stop.load() != 0)
+
+        post(mine, current.front(), best, result.generations);
+        send(outbox, current.front());
+
+        // Migrants take the place of children, which breed() has already
+        // scored; replace() scores each migrant afresh, so the next
+        // selection weighs it on its own fitness. The last child is never
+        // a candidate, so it is left alone.
+        size_t slot = current.size() - 1;
+
+        while (slot > survivors && receive(inbox, migrant))
+        {
+            current.replace(--slot, migrant);
+        } // end while (slot > survivors && receive(inbox, migrant))
+
+        for (int i = 0; i < count && slot > survivors; ++i)
+        {
+            if (i != index &&
+                read(shared->posts[i], migrant, fitness, generation) &&
+                fitness > best)
+            {
+                current.replace(--slot, migrant);
+                best = fitness;
+            } // end if (i != index && ...)
+        } // end for (int i = 0; i < count && slot > survivors; ++i)
+    } // end while (more && island.advance(...))
+
+    island.end(current, result);
+
+    if (result.status == SOLVED)
+    {
+        shared->stop.store(1);
+    } // end if (result.status == SOLVED)
+
+    post(mine, result.best, result.best.fitness(), result.generations);
+    mine.status = result.status;
+    mine.generations = result.generations;
+    mine.evaluations = result.evaluations;
+    mine.validity = result.validity;
+    mine.finished.store(1, memory_order_release);
+} // end voyage(int, uint64_t, SolveLimits&, Shared*)
@@ -0,0 +1,88 @@
+/**
+ * @file    Islands.h
+ * @brief   Solve one puzzle in several processes at once. Each island is a
+ *          forked process with a population and heap of its own, so a crash
+ *          loses one island rather than the run. Every few generations an
+ *          island sends its best Puzzle to the next island around a ring,
+ *          and adopts the best posted by any island if that beats its own.
+ *          The islands meet only in a block of shared memory that holds one
+ *          lock-free ring of migrants and one posted best per island; the
+ *          calling process collects the best of them, reports progress and
+ *          tells the islands to stop once one has solved the puzzle. Runs
+ *          are not repeatable, since migrants arrive whenever the islands
+ *          happen to send them.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#ifndef _ISLANDS_H
+#define	_ISLANDS_H
+
+#include "GeneticAlgorithm.h"
+
+using namespace std;
+
+
+class Islands
+{
+public:
+
+    /** Constructor.
+     * @param engine  The algorithm, with its puzzle, sizes and seed. It must
+     *                not checkpoint or replay; each island is seeded from it.
+     * @param count  The number of island processes, at least 1.
+     * @param interval  Generations between migrations, at least 1.
+     */
+    Islands(const GeneticAlgorithm& engine, int count, int interval);
+
+    /** Destructor.
+     */
+    virtual ~Islands();
+
+    /** Evolve a solution without exceeding the given limits, which apply to
+     *  each island. The generations reported are those of the island with
+     *  the best Puzzle; the evaluations are those of every island.
+     * @param limits  The deadline and budgets for this run.
+     * @pre No other call to run() is in progress.
+     * @post None.
+     * @return The most fit solution found by any island, along with the
+     *         reason its island stopped. If no island finished, the status
+     *         is BUDGET_EXHAUSTED and the best is the puzzle itself.
+     */
+    SolveResult run(const SolveLimits& limits);
+
+    /** Provide the number of islands lost in the last run, whose process
+     *  ended without finishing its run.
+     * @pre None.
+     * @post None.
+     * @return The count of islands lost.
+     */
+    int lost(void) const;
+
+private:
+
+    struct Shared;              // the block all islands map, in Islands.cpp
+
+    GeneticAlgorithm engine;
+    int count;
+    int interval;
+    int casualties;             // islands lost in the last run
+
+    /** Run one island to its end, in its own process.
+     * @param index  Which island.
+     * @param seed  Seeds the island's algorithm.
+     * @param limits  The deadline and budgets for the island.
+     * @param shared  The block shared by every island.
+     * @pre shared is mapped and initialized.
+     * @post The island's outcome is posted in shared.
+     */
+    void voyage(int index, uint64_t seed, const SolveLimits& limits,
+                Shared *shared);
+
+    // Not copyable; a run owns processes.
+    Islands(const Islands& orig);
+    void operator=(const Islands& rhs);
+
+};
+
+#endif	/* _ISLANDS_H */
@@ -0,0 +1,400 @@
+/**
+ * @file    Landscape.cpp
+ * @brief   Measures the shape of a population after selection, to tell a
+ *          run that has converged too early from one lost on a rugged
+ *          landscape: how far apart the survivors are, cell by cell, on a
+ *          sample of pairs; how many rules they break, as a histogram; which
+ *          rows, columns and nonets hold the broken rules; and how many
+ *          founders still have descendants among them. Each measure reads
+ *          only the survivors, and is written to the trace as counter tracks
+ *          beside the generation spans.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#include <algorithm>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "Landscape.h"
+
+static const int CELLS = ROWS * COLUMNS;
+static const int BIN_FLOOR[FITNESS_BINS] = { 0, 1, 2, 3, 4, 6, 8, 12, 16 };
+static const char *BIN_NAMES[FITNESS_BINS] = { "0", "1", "2", "3", "4-5",
+                                               "6-7", "8-11", "12-15", "16+" };
+static const char *UNIT_NAMES[UNITS] = {
+    "row1", "row2", "row3", "row4", "row5", "row6", "row7", "row8", "row9",
+    "col1", "col2", "col3", "col4", "col5", "col6", "col7", "col8", "col9",
+    "box1", "box2", "box3", "box4", "box5", "box6", "box7", "box8", "box9" };
+
+
+/** Find a cell of a unit.
+ * @param unit  The unit: rows first, then columns, then nonets.
+ * @param index  Which of its nine cells, in reading order.
+ * @pre None.
+ * @post None.
+ * @return The index of the cell in the grid.
+ */
+static int unitCell(int unit, int index)
+{
+    if (unit < ROWS)
+    {
+        return unit * COLUMNS + index;
+    }
+    else if (unit < ROWS + COLUMNS)
+    {
+        return index * COLUMNS + unit - ROWS;
+    } // end if (unit < ROWS)
+
+    int nonet = unit - ROWS - COLUMNS;
+
+    return (nonet / 3 * 3 + index / 3) * COLUMNS + nonet % 3 * 3 + index % 3;
+} // end unitCell(int, int)
+
+
+/** Constructor.
+ * @param seed  Seeds the choice of pairs, which draws on no other source of
+ *              randomness, so a measured run is not changed by it.
+ */
+Landscape::Landscape(uint64_t seed) : rng(seed), distance(0.0), lines(0),
+                                      largest(0), strays(0), seen(), grids(),
+                                      fitness(), origins(), copies()
+{
+    fill(bins, bins + FITNESS_BINS, 0);
+    fill(repeats, repeats + UNITS, 0.0);
+} // end constructor
+
+/** Destructor.
+ */
+Landscape::~Landscape()
+{
+} // end destructor
+
+/** Measure the Puzzles of a Population, every one of which is scored, such as
+ *  the survivors left by deleteWorst().
+ * @param pop  The Population.
+ * @pre Every Puzzle of pop has been scored since it was added.
+ * @post Every measure below describes pop.
+ */
+void Landscape::measure(const Population& pop)
+{
+    grids.clear();
+    fitness.clear();
+    origins.clear();
+
+    for (size_t i = 0; i < pop.size(); ++i)
+    {
+        grids.push_back(pop.genome(i));
+        fitness.push_back(pop.score(i));
+        origins.push_back(pop.lineage(i));
+    } // end for (size_t i = 0; i < pop.size(); ++i)
+
+    tally();
+} // end measure(Population&)
+
+/** Measure Puzzles held apart from a Population, such as the survivors of a
+ *  Pipeline. Each is copied first, into storage suited to hamming().
+ * @param puzzles  The Puzzles.
+ * @param scores  The fitness of each.
+ * @param lines  The lineage of each; 0 for none.
+ * @pre scores and lines are the size of puzzles.
+ * @post Every measure below describes puzzles.
+ */
+void Landscape::measure(const vector<Puzzle>& puzzles,
+                        const vector<int>& scores,
+                        const vector<unsigned>& lines)
+{
+    copies.clear();
+
+    for (size_t i = 0; i < puzzles.size(); ++i)
+    {
+        puzzles[i].write(copies.append());
+    } // end for (size_t i = 0; i < puzzles.size(); ++i)
+
+    // Appending may move the copies, so none is taken until all are made.
+    grids.clear();
+
+    for (size_t i = 0; i < copies.size(); ++i)
+    {
+        grids.push_back(copies.genome(i));
+    } // end for (size_t i = 0; i < copies.size(); ++i)
+
+    fitness = scores;
+    origins = lines;
+    tally();
+} // end measure(vector<Puzzle>&, vector<int>&, vector<unsigned>&)
+
+/** Provide the mean number of cells in which two Puzzles differ, over every
+ *  pair or a random sample of SAMPLE_PAIRS of them.
+ * @pre None.
+ * @post None.
+ * @return The mean distance, from 0 for a population of clones to
+ *         ROWS * COLUMNS.
+ */
+double Landscape::diversity(void) const
+{
+    return distance;
+} // end diversity()
+
+/** Provide the number of Puzzles that break a range of rules.
+ * @param bin  Which range, from 0 to FITNESS_BINS - 1.
+ * @pre None.
+ * @post None.
+ * @return The number of Puzzles measured whose broken rules fall in it.
+ */
+int Landscape::histogram(int bin) const
+{
+    return bins[bin];
+} // end histogram(int)
+
+/** Provide the mean number of repeated digits in a unit.
+ * @param unit  Which unit: rows from 0, columns from ROWS, and nonets, left
+ *              to right then down, from ROWS + COLUMNS.
+ * @pre 0 <= unit < UNITS.
+ * @post None.
+ * @return The repeats in unit, averaged over the Puzzles measured.
+ */
+double Landscape::violations(int unit) const
+{
+    return repeats[unit];
+} // end violations(int)
+
+/** Provide the number of founders with descendants among the Puzzles
+ *  measured. Puzzles of no lineage are counted by untracked() instead.
+ * @pre None.
+ * @post None.
+ * @return The number of lineages.
+ */
+int Landscape::lineages(void) const
+{
+    return lines;
+} // end lineages()
+
+/** Provide the number of Puzzles measured in the largest lineage.
+ * @pre None.
+ * @post None.
+ * @return The size of the largest lineage, or 0 if there is none.
+ */
+int Landscape::largestLineage(void) const
+{
+    return largest;
+} // end largestLineage()
+
+/** Provide the number of Puzzles measured that belong to no lineage: those
+ *  that arrived from another island, their descendants, and any placed by
+ *  hand.
+ * @pre None.
+ * @post None.
+ * @return The number of Puzzles of no lineage.
+ */
+int Landscape::untracked(void) const
+{
+    return strays;
+} // end untracked()
+
+/** Write every measure to the trace as counter tracks.
+ * @param profiler  The Profiler whose trace is written.
+ * @pre None.
+ * @post Nothing is written unless a trace is open.
+ */
+void Landscape::exportTo(Profiler& profiler) const
+{
+    static const char *DIVERSITY[] = { "hamming" };
+    static const char *LINEAGE[] = { "lineages", "largest", "untracked" };
+    double values[UNITS];
+
+    profiler.counter("diversity", DIVERSITY, &distance, 1);
+
+    for (int i = 0; i < FITNESS_BINS; ++i)
+    {
+        values[i] = bins[i];
+    } // end for (int i = 0; i < FITNESS_BINS; ++i)
+
+    profiler.counter("broken rules", BIN_NAMES, values, FITNESS_BINS);
+    profiler.counter("repeats by row", UNIT_NAMES, repeats, ROWS);
+    profiler.counter("repeats by column", UNIT_NAMES + ROWS, repeats + ROWS,
+                     COLUMNS);
+    profiler.counter("repeats by nonet", UNIT_NAMES + ROWS + COLUMNS,
+                     repeats + ROWS + COLUMNS, ROWS);
+
+    values[0] = lines;
+    values[1] = largest;
+    values[2] = strays;
+    profiler.counter("lineage", LINEAGE, values, 3);
+} // end exportTo(Profiler&)
+
+/** Measure a Population and write it to the global trace, if one is open,
+ *  with a Landscape kept for the calling thread.
+ * @param pop  The Population, as for measure().
+ * @pre As for measure().
+ * @post None.
+ */
+void Landscape::profile(const Population& pop)
+{
+    static thread_local Landscape local;
+    Profiler& profiler = Profiler::global();
+
+    if (profiler.tracing())
+    {
+        local.measure(pop);
+        local.exportTo(profiler);
+    } // end if (profiler.tracing())
+} // end profile(Population&)
+
+/** Measure Puzzles held apart from a Population and write them to the global
+ *  trace, if one is open, with a Landscape kept for the calling thread.
+ * @param puzzles  The Puzzles, as for measure().
+ * @param scores  The fitness of each.
+ * @param lines  The lineage of each; 0 for none.
+ * @pre As for measure().
+ * @post None.
+ */
+void Landscape::profile(const vector<Puzzle>& puzzles,
+                        const vector<int>& scores,
+                        const vector<unsigned>& lines)
+{
+    static thread_local Landscape local;
+    Profiler& profiler = Profiler::global();
+
+    if (profiler.tracing())
+    {
+        local.measure(puzzles, scores, lines);
+        local.exportTo(profiler);
+    } // end if (profiler.tracing())
+} // end profile(vector<Puzzle>&, vector<int>&, vector<unsigned>&)
+
+/** Take every measure of the Puzzles gathered by measure().
+ * @pre grids, fitness and origins describe the same Puzzles, in order.
+ * @post Every measure describes them.
+ */
+void Landscape::tally(void)
+{
+    size_t count = grids.size();
+    long pairs = static_cast<long>(count) * (static_cast<long>(count) - 1) / 2;
+    long total = 0;
+
+    // Small populations are compared in full; larger ones on a sample.
+    if (pairs <= SAMPLE_PAIRS)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            for (size_t j = i + 1; j < count; ++j)
+            {
+                total += hamming(grids[i], grids[j]);
+            } // end for (size_t j = i + 1; j < count; ++j)
+        } // end for (size_t i = 0; i < count; ++i)
+    }
+    else
+    {
+        for (int k = 0; k < SAMPLE_PAIRS; ++k)
+        {
+            size_t i = rng.below(count);
+            size_t j = rng.below(count - 1);
+
+            j += j >= i ? 1 : 0;            // any but i, equally likely
+            total += hamming(grids[i], grids[j]);
+        } // end for (int k = 0; k < SAMPLE_PAIRS; ++k)
+
+        pairs = SAMPLE_PAIRS;
+    } // end if (pairs <= SAMPLE_PAIRS)
+
+    distance = pairs > 0 ? static_cast<double>(total) / pairs : 0.0;
+
+    fill(bins, bins + FITNESS_BINS, 0);
+    fill(repeats, repeats + UNITS, 0.0);
+    seen.clear();
+    strays = 0;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const char *cells = grids[i];
+        int broken = CELLS - fitness[i];
+        int bin = FITNESS_BINS - 1;
+
+        while (bin > 0 && broken < BIN_FLOOR[bin])
+        {
+            --bin;
+        } // end while (bin > 0 && broken < BIN_FLOOR[bin])
+
+        ++bins[bin];
+
+        // A unit's repeats are its filled cells less its distinct digits,
+        // which is what the fitness takes off for it.
+        for (int unit = 0; unit < UNITS; ++unit)
+        {
+            int digits = 0, filled = 0;
+
+            for (int j = 0; j < COLUMNS; ++j)
+            {
+                char cell = cells[unitCell(unit, j)];
+
+                if (cell != '0')
+                {
+                    digits |= 1 << (cell - '0');
+                    ++filled;
+                } // end if (cell != '0')
+            } // end for (int j = 0; j < COLUMNS; ++j)
+
+            repeats[unit] += filled - __builtin_popcount(digits);
+        } // end for (int unit = 0; unit < UNITS; ++unit)
+
+        if (origins[i] != 0)
+        {
+            seen.push_back(origins[i]);
+        }
+        else
+        {
+            ++strays;
+        } // end if (origins[i] != 0)
+    } // end for (size_t i = 0; i < count; ++i)
+
+    for (int unit = 0; unit < UNITS && count > 0; ++unit)
+    {
+        repeats[unit] /= count;
+    } // end for (int unit = 0; unit < UNITS && count > 0; ++unit)
+
+    // Sorted, each lineage is a run of equal values.
+    sort(seen.begin(), seen.end());
+    lines = largest = 0;
+
+    for (size_t i = 0, run = 0; i < seen.size(); ++i)
+    {
+        run = i > 0 && seen[i] == seen[i - 1] ? run + 1 : 1;
+        lines += run == 1 ? 1 : 0;
+        largest = max(largest, static_cast<int>(run));
+    } // end for (size_t i = 0, run = 0; i < seen.size(); ++i)
+} // end tally()
+
+/** Count the cells in which two Puzzles differ.
+ * @param lhs  The cells of one.
+ * @param rhs  The cells of the other.
+ * @pre Both are genomes of a Population, so they are 16-byte aligned and
+ *      padded past ROWS * COLUMNS.
+ * @post None.
+ * @return The number of cells that differ.
+ */
+int Landscape::hamming(const char *lhs, const char *rhs)
+{
+    int same = 0;
+    int i = 0;
+
+#ifdef __SSE2__
+    // Sixteen cells at a time: each equal byte sets a bit of the mask.
+    for (; i + 16 <= CELLS; i += 16)
+    {
+        __m128i a = _mm_load_si128(reinterpret_cast<const __m128i*>(lhs + i));
+        __m128i b = _mm_load_si128(reinterpret_cast<const __m128i*>(rhs + i));
+
+        same += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+    } // end for (; i + 16 <= CELLS; i += 16)
+#endif
+
+    for (; i < CELLS; ++i)
+    {
+        same += lhs[i] == rhs[i] ? 1 : 0;
+    } // end for (; i < CELLS; ++i)
+
+    return CELLS - same;
+} // end hamming(char*, char*)
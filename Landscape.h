@@ -0,0 +1,186 @@
+/**
+ * @file    Landscape.h
+ * @brief   Measures the shape of a population after selection, to tell a
+ *          run that has converged too early from one lost on a rugged
+ *          landscape: how far apart the survivors are, cell by cell, on a
+ *          sample of pairs; how many rules they break, as a histogram; which
+ *          rows, columns and nonets hold the broken rules; and how many
+ *          founders still have descendants among them. Each measure reads
+ *          only the survivors, and is written to the trace as counter tracks
+ *          beside the generation spans.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#ifndef _LANDSCAPE_H
+#define	_LANDSCAPE_H
+
+#include <vector>
+
+#include "Population.h"
+#include "Profiler.h"
+#include "Random.h"
+
+using namespace std;
+
+const int FITNESS_BINS = 9;     // broken rules: 0-3, then from 4, 6, 8, 12, 16
+const int SAMPLE_PAIRS = 64;    // pairs compared for diversity, at most
+
+
+class Landscape
+{
+public:
+
+    /** Constructor.
+     * @param seed  Seeds the choice of pairs, which draws on no other source
+     *              of randomness, so a measured run is not changed by it.
+     */
+    explicit Landscape(uint64_t seed = 1);
+
+    /** Destructor.
+     */
+    virtual ~Landscape();
+
+    /** Measure the Puzzles of a Population, every one of which is scored,
+     *  such as the survivors left by deleteWorst().
+     * @param pop  The Population.
+     * @pre Every Puzzle of pop has been scored since it was added.
+     * @post Every measure below describes pop.
+     */
+    void measure(const Population& pop);
+
+    /** Measure Puzzles held apart from a Population, such as the survivors
+     *  of a Pipeline. Each is copied first, into storage suited to
+     *  hamming().
+     * @param puzzles  The Puzzles.
+     * @param scores  The fitness of each.
+     * @param lines  The lineage of each; 0 for none.
+     * @pre scores and lines are the size of puzzles.
+     * @post Every measure below describes puzzles.
+     */
+    void measure(const vector<Puzzle>& puzzles, const vector<int>& scores,
+                 const vector<unsigned>& lines);
+
+    /** Provide the mean number of cells in which two Puzzles differ, over
+     *  every pair or a random sample of SAMPLE_PAIRS of them.
+     * @pre None.
+     * @post None.
+     * @return The mean distance, from 0 for a population of clones to
+     *         ROWS * COLUMNS.
+     */
+    double diversity(void) const;
+
+    /** Provide the number of Puzzles that break a range of rules.
+     * @param bin  Which range, from 0 to FITNESS_BINS - 1.
+     * @pre None.
+     * @post None.
+     * @return The number of Puzzles measured whose broken rules fall in it.
+     */
+    int histogram(int bin) const;
+
+    /** Provide the mean number of repeated digits in a unit.
+     * @param unit  Which unit: rows from 0, columns from ROWS, and nonets,
+     *              left to right then down, from ROWS + COLUMNS.
+     * @pre 0 <= unit < UNITS.
+     * @post None.
+     * @return The repeats in unit, averaged over the Puzzles measured.
+     */
+    double violations(int unit) const;
+
+    /** Provide the number of founders with descendants among the Puzzles
+     *  measured. Puzzles of no lineage are counted by untracked() instead.
+     * @pre None.
+     * @post None.
+     * @return The number of lineages.
+     */
+    int lineages(void) const;
+
+    /** Provide the number of Puzzles measured in the largest lineage.
+     * @pre None.
+     * @post None.
+     * @return The size of the largest lineage, or 0 if there is none.
+     */
+    int largestLineage(void) const;
+
+    /** Provide the number of Puzzles measured that belong to no lineage:
+     *  those that arrived from another island, their descendants, and any
+     *  placed by hand.
+     * @pre None.
+     * @post None.
+     * @return The number of Puzzles of no lineage.
+     */
+    int untracked(void) const;
+
+    /** Write every measure to the trace as counter tracks.
+     * @param profiler  The Profiler whose trace is written.
+     * @pre None.
+     * @post Nothing is written unless a trace is open.
+     */
+    void exportTo(Profiler& profiler) const;
+
+    /** Measure a Population and write it to the global trace, if one is
+     *  open, with a Landscape kept for the calling thread.
+     * @param pop  The Population, as for measure().
+     * @pre As for measure().
+     * @post None.
+     */
+    static void profile(const Population& pop);
+
+    /** Measure Puzzles held apart from a Population and write them to the
+     *  global trace, if one is open, with a Landscape kept for the calling
+     *  thread.
+     * @param puzzles  The Puzzles, as for measure().
+     * @param scores  The fitness of each.
+     * @param lines  The lineage of each; 0 for none.
+     * @pre As for measure().
+     * @post None.
+     */
+    static void profile(const vector<Puzzle>& puzzles,
+                        const vector<int>& scores,
+                        const vector<unsigned>& lines);
+
+private:
+
+    Random rng;                     // chooses the pairs to compare
+    double distance;                // mean over the pairs compared
+    int bins[FITNESS_BINS];
+    double repeats[UNITS];          // mean per Puzzle
+    int lines;
+    int largest;
+    int strays;                     // Puzzles of no lineage
+    vector<unsigned> seen;          // lineages of the Puzzles, for sorting
+    vector<const char*> grids;      // the cells of each Puzzle measured
+    vector<int> fitness;            // ... its score
+    vector<unsigned> origins;       // ... and its lineage
+    Population copies;              // cells of Puzzles held apart
+
+    /** Take every measure of the Puzzles gathered by measure().
+     * @pre grids, fitness and origins describe the same Puzzles, in order.
+     * @post Every measure describes them.
+     */
+    void tally(void);
+
+    /** Count the cells in which two Puzzles differ.
+     * @param lhs  The cells of one.
+     * @param rhs  The cells of the other.
+     * @pre Both are genomes of a Population, so they are 16-byte aligned
+     *      and padded past ROWS * COLUMNS.
+     * @post None.
+     * @return The number of cells that differ.
+     */
+    static int hamming(const char *lhs, const char *rhs);
+
+    // Not copyable; there is no need.
+    Landscape(const Landscape& orig);
+    void operator=(const Landscape& rhs);
+
+};
+
+
+#ifdef SUDOKU_PROFILE
+#define PROFILE_LANDSCAPE(...) Landscape::profile(__VA_ARGS__)
+#else
+#define PROFILE_LANDSCAPE(...)
+#endif
+
+#endif	/* _LANDSCAPE_H */
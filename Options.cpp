@@ -0,0 +1,143 @@
+/**
+ * @file    Options.cpp
+ * @brief   Helpers shared by the command-line programs for reading their
+ *          arguments. Options take the form --name=value; every number is
+ *          checked in full, so a typo is reported instead of read as 0.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+
+#include "Options.h"
+
+
+/** Find the value of a --name=value argument.
+ * @param arg  One command-line argument.
+ * @param name  The option name, including the leading dashes and the '='.
+ * @pre None.
+ * @post None.
+ * @return The text after the '=', or NULL if arg is not that option.
+ */
+const char *optionValue(const char *arg, const char *name)
+{
+    size_t length = strlen(name);
+
+    return strncmp(arg, name, length) == 0 ? arg + length : NULL;
+} // end optionValue(char*, char*)
+
+/** Convert an argument to a whole number within a range.
+ * @param text  The argument.
+ * @param low  The smallest acceptable value.
+ * @param value  Set to the number if it is acceptable.
+ * @pre None.
+ * @post value is unchanged unless true is returned.
+ * @return true if text is entirely a number no less than low, false
+ *         otherwise.
+ */
+bool parseCount(const char *text, long low, int& value)
+{
+    char *end;
+    long number;
+
+    if (text == NULL)
+    {
+        return false;
+    } // end if (text == NULL)
+
+    errno = 0;
+    number = strtol(text, &end, 10);
+
+    if (end == text || *end != '\0' || errno != 0 || number < low ||
+        number > INT_MAX)
+    {
+        return false;
+    } // end if (end == text || *end != '\0' || errno != 0 || number < low)
+
+    value = static_cast<int>(number);
+
+    return true;
+} // end parseCount(char*, long, int&)
+
+/** Convert an argument to an unsigned 64-bit number, such as a seed.
+ * @param text  The argument.
+ * @param value  Set to the number if it is acceptable.
+ * @pre None.
+ * @post value is unchanged unless true is returned.
+ * @return true if text is entirely a number, false otherwise.
+ */
+bool parseSeed(const char *text, uint64_t& value)
+{
+    char *end;
+    unsigned long long number;
+
+    if (text == NULL || *text == '-')
+    {
+        return false;
+    } // end if (text == NULL || *text == '-')
+
+    errno = 0;
+    number = strtoull(text, &end, 0);
+
+    if (end == text || *end != '\0' || errno != 0)
+    {
+        return false;
+    } // end if (end == text || *end != '\0' || errno != 0)
+
+    value = number;
+
+    return true;
+} // end parseSeed(char*, uint64_t&)
+
+/** Convert an argument to a positive number of seconds.
+ * @param text  The argument.
+ * @param value  Set to the number if it is acceptable.
+ * @pre None.
+ * @post value is unchanged unless true is returned.
+ * @return true if text is entirely a number greater than 0, false otherwise.
+ */
+bool parseSeconds(const char *text, double& value)
+{
+    char *end;
+    double number;
+
+    if (text == NULL)
+    {
+        return false;
+    } // end if (text == NULL)
+
+    number = strtod(text, &end);
+
+    if (end == text || *end != '\0' || !(number > 0.0))
+    {
+        return false;
+    } // end if (end == text || *end != '\0' || !(number > 0.0))
+
+    value = number;
+
+    return true;
+} // end parseSeconds(char*, double&)
+
+/** Convert an argument to a fraction greater than 0 and no more than 1.
+ * @param text  The argument.
+ * @param value  Set to the number if it is acceptable.
+ * @pre None.
+ * @post value is unchanged unless true is returned.
+ * @return true if text is entirely a number in (0, 1], false otherwise.
+ */
+bool parseFraction(const char *text, double& value)
+{
+    double number;
+
+    if (!parseSeconds(text, number) || number > 1.0)
+    {
+        return false;
+    } // end if (!parseSeconds(text, number) || number > 1.0)
+
+    value = number;
+
+    return true;
+} // end parseFraction(char*, double&)
@@ -0,0 +1,63 @@
+/**
+ * @file    Options.h
+ * @brief   Helpers shared by the command-line programs for reading their
+ *          arguments. Options take the form --name=value; every number is
+ *          checked in full, so a typo is reported instead of read as 0.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#ifndef _OPTIONS_H
+#define	_OPTIONS_H
+
+#include <stdint.h>
+
+
+/** Find the value of a --name=value argument.
+ * @param arg  One command-line argument.
+ * @param name  The option name, including the leading dashes and the '='.
+ * @pre None.
+ * @post None.
+ * @return The text after the '=', or NULL if arg is not that option.
+ */
+const char *optionValue(const char *arg, const char *name);
+
+/** Convert an argument to a whole number within a range.
+ * @param text  The argument.
+ * @param low  The smallest acceptable value.
+ * @param value  Set to the number if it is acceptable.
+ * @pre None.
+ * @post value is unchanged unless true is returned.
+ * @return true if text is entirely a number no less than low, false
+ *         otherwise.
+ */
+bool parseCount(const char *text, long low, int& value);
+
+/** Convert an argument to an unsigned 64-bit number, such as a seed.
+ * @param text  The argument.
+ * @param value  Set to the number if it is acceptable.
+ * @pre None.
+ * @post value is unchanged unless true is returned.
+ * @return true if text is entirely a number, false otherwise.
+ */
+bool parseSeed(const char *text, uint64_t& value);
+
+/** Convert an argument to a positive number of seconds.
+ * @param text  The argument.
+ * @param value  Set to the number if it is acceptable.
+ * @pre None.
+ * @post value is unchanged unless true is returned.
+ * @return true if text is entirely a number greater than 0, false otherwise.
+ */
+bool parseSeconds(const char *text, double& value);
+
+/** Convert an argument to a fraction greater than 0 and no more than 1.
+ * @param text  The argument.
+ * @param value  Set to the number if it is acceptable.
+ * @pre None.
+ * @post value is unchanged unless true is returned.
+ * @return true if text is entirely a number in (0, 1], false otherwise.
+ */
+bool parseFraction(const char *text, double& value);
+
+#endif	/* _OPTIONS_H */
@@ -0,0 +1,296 @@
+/**
+ * @file    Pipeline.cpp
+ * @brief   Solve one puzzle on several threads at once. Breeding, scoring and
+ *          selection run as separate stages, joined by bounded queues that
+ *          carry children in chunks. The survivors are updated one chunk at
+ *          a time rather than one generation at a time, so no stage waits
+ *          for a whole generation to finish: breeders draw parents from the
+ *          survivors as they stand, and a child replaces the worst survivor
+ *          as soon as it is scored higher. Runs are not repeatable, since
+ *          the order in which chunks arrive depends on the threads.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#include "Landscape.h"
+#include "Pipeline.h"
+#include "Profiler.h"
+
+static const int CHUNK = 64;            // children passed between stages
+
+
+/** Constructor.
+ * @param engine  The algorithm, with its puzzle, sizes and seed.
+ * @param threads  The number of threads to breed and score on, shared between
+ *                 the two stages; selection runs on the caller.
+ */
+Pipeline::Pipeline(const GeneticAlgorithm& engine, int threads) :
+    engine(engine), breeders(max(1, threads / 2)),
+    scorers(max(1, threads - threads / 2)), survivorLock(), survivors(),
+    survivorScores(), survivorLines(), version(0), bred(2 * max(1, threads)),
+    scored(2 * max(1, threads))
+{
+} // end constructor
+
+/** Destructor.
+ */
+Pipeline::~Pipeline()
+{
+} // end destructor
+
+/** Evolve a solution without exceeding the given limits. Limits are checked
+ *  after every chunk. A generation is counted for every population's worth of
+ *  children scored.
+ * @param limits  The deadline and budgets for this run.
+ * @pre No other call to run() is in progress.
+ * @post None.
+ * @return The most fit solution found before a limit was hit, along with the
+ *         reason the run stopped.
+ */
+SolveResult Pipeline::run(const SolveLimits& limits)
+{
+    SolveResult result;
+    Population current;
+    vector<thread> stages;
+    Chunk chunk;
+
+    // The first generation is made and selected as evolve() would.
+    if (!engine.begin(limits, current, result))
+    {
+        engine.end(current, result);
+        return result;
+    } // end if (!engine.begin(limits, current, result))
+
+    result.evaluations += current.size();
+    ++result.generations;
+    current.deleteWorst(engine.settings.survivors(engine.popSize));
+    engine.end(current, result);
+
+    survivors.assign(current.begin(), current.end());
+    survivorScores.resize(current.size());
+    survivorLines.resize(current.size());
+
+    for (size_t i = 0; i < current.size(); ++i)
+    {
+        survivorScores[i] = current.score(i);
+        survivorLines[i] = current.lineage(i);
+    } // end for (size_t i = 0; i < current.size(); ++i)
+
+    bool cancelled = engine.listener != NULL &&
+                     !engine.report(survivors.front(), survivorScores[0],
+                                    result.generations);
+
+    if (survivorScores[0] == IDEAL)
+    {
+        result.status = SOLVED;
+        return result;
+    } // end if (survivorScores[0] == IDEAL)
+
+    if (cancelled)
+    {
+        result.status = CANCELLED;
+        return result;
+    } // end if (cancelled)
+
+    for (int i = 0; i < breeders; ++i)
+    {
+        stages.push_back(thread(&Pipeline::breed, this, engine.rng.next()));
+    } // end for (int i = 0; i < breeders; ++i)
+
+    for (int i = 0; i < scorers; ++i)
+    {
+        stages.push_back(thread(&Pipeline::score, this));
+    } // end for (int i = 0; i < scorers; ++i)
+
+    result.status = GENERATIONS_EXHAUSTED;
+    PROFILE_GENERATION(0, 0);
+
+    while (scored.pop(chunk))
+    {
+        long count = chunk.children.size();
+        int finished = result.generations;
+
+        if (limits.maxEvaluations > 0 &&
+            result.evaluations + count > limits.maxEvaluations)
+        {
+            result.status = BUDGET_EXHAUSTED;
+            break;
+        } // end if (limits.maxEvaluations > 0 && ...)
+
+        result.evaluations += count;
+        result.generations = result.evaluations / engine.popSize;
+        select(chunk);
+
+        // Only this thread changes the survivors, so they can be read here
+        // without the lock.
+        if (result.generations > finished)
+        {
+            PROFILE_GENERATION(result.generations, survivorScores[0]);
+            PROFILE_LANDSCAPE(survivors, survivorScores, survivorLines);
+        } // end if (result.generations > finished)
+
+        cancelled = engine.listener != NULL &&
+                    survivorScores[0] > engine.reported &&
+                    !engine.report(survivors.front(), survivorScores[0],
+                                   result.generations);
+
+        if (survivorScores[0] == IDEAL)
+        {
+            result.status = SOLVED;
+            break;
+        } // end if (survivorScores[0] == IDEAL)
+
+        if (cancelled)
+        {
+            result.status = CANCELLED;
+            break;
+        } // end if (cancelled)
+
+        if (result.generations >= engine.maxGens)
+        {
+            break;
+        } // end if (result.generations >= engine.maxGens)
+
+        if (limits.hasDeadline && SolveLimits::Clock::now() >= limits.deadline)
+        {
+            result.status = TIMED_OUT;
+            break;
+        } // end if (limits.hasDeadline && ...)
+    } // end while (scored.pop(chunk))
+
+    // Closing both queues releases every stage, wherever it is waiting.
+    bred.close();
+    scored.close();
+
+    for (size_t i = 0; i < stages.size(); ++i)
+    {
+        stages[i].join();
+    } // end for (size_t i = 0; i < stages.size(); ++i)
+
+    result.best = survivors.front();
+
+    return result;
+} // end run(SolveLimits&)
+
+/** Breed chunks of children from the current survivors until stopped.
+ * @param seed  Seeds this breeder's source of randomness.
+ * @pre The survivors are not empty.
+ * @post None.
+ */
+void Pipeline::breed(uint64_t seed)
+{
+    Random source(seed);
+    vector<Puzzle> parents;
+    vector<unsigned> lines;
+    long seen = -1;
+    Chunk chunk;
+
+    do
+    {
+        // Parents are copied only when selection has changed them.
+        {
+            lock_guard<mutex> guard(survivorLock);
+
+            if (version != seen)
+            {
+                parents = survivors;
+                lines = survivorLines;
+                seen = version;
+            } // end if (version != seen)
+        }
+
+        chunk.children.clear();
+        chunk.lines.clear();
+
+        // Each child is of its parent's lineage.
+        for (int i = 0; i < CHUNK; ++i)
+        {
+            size_t parent = source.below(parents.size());
+
+            chunk.children.push_back(engine.mutate(
+                parents[parent], engine.settings.mutantiness, source));
+            chunk.lines.push_back(lines[parent]);
+        } // end for (int i = 0; i < CHUNK; ++i)
+    } while (bred.push(chunk)); // end do
+} // end breed(uint64_t)
+
+/** Score chunks of children until stopped.
+ * @pre None.
+ * @post None.
+ */
+void Pipeline::score(void)
+{
+    Chunk chunk;
+    char cells[ROWS * COLUMNS];
+
+    while (bred.pop(chunk))
+    {
+        chunk.scores.resize(chunk.children.size());
+
+        for (size_t i = 0; i < chunk.children.size(); ++i)
+        {
+            chunk.children[i].write(cells);
+            chunk.scores[i] = engine.evaluator.fitness(cells);
+        } // end for (size_t i = 0; i < chunk.children.size(); ++i)
+
+        if (!scored.push(chunk))
+        {
+            break;
+        } // end if (!scored.push(chunk))
+    } // end while (bred.pop(chunk))
+} // end score()
+
+/** Let the children of a chunk replace the survivors they beat.
+ * @param chunk  Scored children.
+ * @pre None.
+ * @post The survivors are the best of themselves and chunk, without
+ *       duplicates.
+ */
+void Pipeline::select(const Chunk& chunk)
+{
+    lock_guard<mutex> guard(survivorLock);
+    bool changed = false;
+
+    for (size_t i = 0; i < chunk.children.size(); ++i)
+    {
+        int fitness = chunk.scores[i];
+        size_t place = survivors.size();
+
+        if (fitness <= survivorScores.back())
+        {
+            continue;
+        } // end if (fitness <= survivorScores.back())
+
+        // Find where it belongs, behind those it ties with; a copy of one of
+        // those would only crowd out variety.
+        while (place > 0 && survivorScores[place - 1] < fitness)
+        {
+            --place;
+        } // end while (place > 0 && survivorScores[place - 1] < fitness)
+
+        bool copy = false;
+
+        for (size_t j = place; j > 0 && survivorScores[j - 1] == fitness; --j)
+        {
+            copy = copy || survivors[j - 1] == chunk.children[i];
+        } // end for (size_t j = place; j > 0 && ...; --j)
+
+        if (copy)
+        {
+            continue;
+        } // end if (copy)
+
+        survivors.pop_back();
+        survivorScores.pop_back();
+        survivorLines.pop_back();
+        survivors.insert(survivors.begin() + place, chunk.children[i]);
+        survivorScores.insert(survivorScores.begin() + place, fitness);
+        survivorLines.insert(survivorLines.begin() + place, chunk.lines[i]);
+        changed = true;
+    } // end for (size_t i = 0; i < chunk.children.size(); ++i)
+
+    if (changed)
+    {
+        ++version;
+    } // end if (changed)
+} // end select(Chunk&)
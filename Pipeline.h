@@ -0,0 +1,104 @@
+/**
+ * @file    Pipeline.h
+ * @brief   Solve one puzzle on several threads at once. Breeding, scoring and
+ *          selection run as separate stages, joined by bounded queues that
+ *          carry children in chunks. The survivors are updated one chunk at
+ *          a time rather than one generation at a time, so no stage waits
+ *          for a whole generation to finish: breeders draw parents from the
+ *          survivors as they stand, and a child replaces the worst survivor
+ *          as soon as it is scored higher. Runs are not repeatable, since
+ *          the order in which chunks arrive depends on the threads.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#ifndef _PIPELINE_H
+#define	_PIPELINE_H
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "BoundedQueue.h"
+#include "GeneticAlgorithm.h"
+
+using namespace std;
+
+
+class Pipeline
+{
+public:
+
+    /** Constructor.
+     * @param engine  The algorithm, with its puzzle, sizes and seed.
+     * @param threads  The number of threads to breed and score on, shared
+     *                 between the two stages; selection runs on the caller.
+     */
+    Pipeline(const GeneticAlgorithm& engine, int threads);
+
+    /** Destructor.
+     */
+    virtual ~Pipeline();
+
+    /** Evolve a solution without exceeding the given limits. Limits are
+     *  checked after every chunk. A generation is counted for every
+     *  population's worth of children scored.
+     * @param limits  The deadline and budgets for this run.
+     * @pre No other call to run() is in progress.
+     * @post None.
+     * @return The most fit solution found before a limit was hit, along with
+     *         the reason the run stopped.
+     */
+    SolveResult run(const SolveLimits& limits);
+
+private:
+
+    /** Children passed from stage to stage, with their lineages and, once
+     *  scored, their fitness.
+     */
+    struct Chunk
+    {
+        vector<Puzzle> children;
+        vector<unsigned> lines;
+        vector<int> scores;
+    };
+
+    GeneticAlgorithm engine;
+    int breeders;
+    int scorers;
+    mutex survivorLock;         // guards the four members below
+    vector<Puzzle> survivors;   // best first
+    vector<int> survivorScores;
+    vector<unsigned> survivorLines;
+    long version;               // changed whenever the survivors change
+    BoundedQueue<Chunk> bred;
+    BoundedQueue<Chunk> scored;
+
+    /** Breed chunks of children from the current survivors until stopped.
+     * @param seed  Seeds this breeder's source of randomness.
+     * @pre The survivors are not empty.
+     * @post None.
+     */
+    void breed(uint64_t seed);
+
+    /** Score chunks of children until stopped.
+     * @pre None.
+     * @post None.
+     */
+    void score(void);
+
+    /** Let the children of a chunk replace the survivors they beat.
+     * @param chunk  Scored children.
+     * @pre None.
+     * @post The survivors are the best of themselves and chunk, without
+     *       duplicates.
+     */
+    void select(const Chunk& chunk);
+
+    // Not copyable; a run owns threads.
+    Pipeline(const Pipeline& orig);
+    void operator=(const Pipeline& rhs);
+
+};
+
+#endif	/* _PIPELINE_H */
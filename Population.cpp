@@ -1,49 +1,512 @@
 /**
  * @file    Population.cpp
- * @brief   Stores a populations of Puzzles to be tested as solutions.
+ * @brief   Stores a populations of Puzzles to be tested as solutions. The
+ *          cells of every Puzzle are kept together in one aligned block, and
+ *          their fitness in a parallel array of ints, so that scoring a
+ *          generation walks memory in order and selection sorts only an
+ *          array of indexes. Puzzles are copied in and out by value.
  * @author  Brendan Sweeney, SID 1161837
  * @date    November 22, 2011
  */
 
+#include <cstring>
+#include <stdint.h>
+
 #include "Population.h"
+#include "Profiler.h"
+
+static const size_t ALIGNMENT = 64;     // a cache line
+static const int PERFECT = ROWS * COLUMNS;  // no rule broken
+
+
+/** Orders indexes by the scores they refer to, best first, as Puzzle's
+ *  operator< orders Puzzles. Ties go to the lower index, so that the order
+ *  is the same whatever the sort is given beside them.
+ */
+struct ByScore
+{
+    const int *scores;
+
+    bool operator()(int lhs, int rhs) const
+    {
+        return scores[lhs] > scores[rhs] ||
+               (scores[lhs] == scores[rhs] && lhs < rhs);
+    } // end operator()(int, int)
+};
+
+
+/** Default constructor.
+ */
+Population::const_iterator::const_iterator() : container(NULL), cur(0)
+{
+} // end default constructor
+
+/** Constructor.
+ * @param aPopulation  The Population to iterate through.
+ * @param index  Initial index in the Population.
+ */
+Population::const_iterator::const_iterator(const Population *aPopulation,
+                                           size_t index) :
+    container(aPopulation), cur(index)
+{
+} // end constructor
+
+/** Build a copy of the Puzzle at which this iterator points.
+ * @pre This iterator points at a Puzzle of its Population.
+ * @post None.
+ * @return The Puzzle.
+ */
+Puzzle Population::const_iterator::operator*(void) const
+{
+    Puzzle copy;
+
+    copy.read(container->genome(cur));
+
+    return copy;
+} // end operator*()
+
+/** Move this iterator to the next Puzzle.
+ * @pre None.
+ * @post This iterator points one Puzzle further on.
+ * @return This iterator.
+ */
+Population::const_iterator& Population::const_iterator::operator++(void)
+{
+    ++cur;
+
+    return *this;
+} // end operator++()
+
+/** Compares this iterator with another for equality.
+ * @param rhs  The iterator with which to compare.
+ * @pre None.
+ * @post None.
+ * @return true if both point at the same place, false otherwise.
+ */
+bool Population::const_iterator::operator==(const const_iterator& rhs) const
+{
+    return container == rhs.container && cur == rhs.cur;
+} // end operator==(const_iterator&)
 
+/** Compares this iterator with another for inequality.
+ * @param rhs  The iterator with which to compare.
+ * @pre None.
+ * @post None.
+ * @return true if they point at different places, false otherwise.
+ */
+bool Population::const_iterator::operator!=(const const_iterator& rhs) const
+{
+    return !(*this == rhs);
+} // end operator!=(const_iterator&)
 
 /** Default constructor.
  */
-Population::Population()
+Population::Population() : genomes(NULL), spare(NULL), scores(NULL),
+                           order(NULL), block(NULL), count(0), room(0),
+                           scored(0), evaluator(NULL), bestFitness(0)
 {
+    cutoffs.scored = cutoffs.culled = 0;
+    cutoffs.checksMade = cutoffs.checksSkipped = 0;
 } // end default constructor
 
 /** Copy constructor.
  * @param orig  The Population to be copied.
  */
-Population::Population(const Population& orig)
+Population::Population(const Population& orig) : genomes(NULL), spare(NULL),
+                                                  scores(NULL), order(NULL),
+                                                  block(NULL), count(0),
+                                                  room(0), scored(0),
+                                                  evaluator(NULL),
+                                                  bestFitness(0)
 {
+    cutoffs.scored = cutoffs.culled = 0;
+    cutoffs.checksMade = cutoffs.checksSkipped = 0;
+    *this = orig;
 } // end copy constructor
 
 /** Destructor.
  */
 Population::~Population()
 {
+    if (block != NULL)
+    {
+        ArenaPool::local().deallocate(block, footprint(room));
+    } // end if (block != NULL)
 } // end destructor
 
-/** Remove the 90% of the population with the lowest fitness.
+/** Assign an existing Population's Puzzles to this object.
+ * @param rhs  The Population with the values to be assigned.
+ * @pre None.
+ * @post This object is a duplicate of rhs. rhs is unchanged.
+ */
+void Population::operator=(const Population& rhs)
+{
+    if (this == &rhs)
+    {
+        return;
+    } // end if (this == &rhs)
+
+    clear();
+    reserve(rhs.count);
+
+    if (rhs.count > 0)
+    {
+        memcpy(genomes, rhs.genomes, rhs.count * GENOME_STRIDE);
+        memcpy(scores, rhs.scores, rhs.count * sizeof(int));
+    } // end if (rhs.count > 0)
+
+    count = rhs.count;
+    scored = rhs.scored;
+    evaluator = rhs.evaluator;
+    cutoffs = rhs.cutoffs;
+    bestFitness = rhs.bestFitness;
+} // end operator=(Population&)
+
+/** Add a Puzzle at the end of the Population.
+ * @param item  The Puzzle to add.
+ * @pre None.
+ * @post The Population holds a copy of item at its end.
+ */
+void Population::push_back(const Puzzle& item)
+{
+    item.write(append());
+} // end push_back(Puzzle&)
+
+/** Put a Puzzle in place of another, such as a child not yet selected. If
+ *  the one replaced was scored, the new one is scored in full in its place,
+ *  so that deleteWorst() judges it on its own fitness.
+ * @param index  Which Puzzle to replace.
+ * @param item  The Puzzle to put there.
+ * @pre index < size().
+ * @post The Population holds a copy of item at index, of no lineage.
+ */
+void Population::replace(size_t index, const Puzzle& item)
+{
+    item.write(genomes + index * GENOME_STRIDE);
+    setLineage(index, 0);
+
+    if (index < scored)
+    {
+        scores[index] = rate(index, CULLED);
+    } // end if (index < scored)
+} // end replace(size_t, Puzzle&)
+
+/** Add a Puzzle at the end of the Population, to be filled in place.
+ * @pre None.
+ * @post The Population holds one more Puzzle, whose cells are not set, of
+ *       no lineage.
+ * @return Its ROWS * COLUMNS cells, valid until the Population changes.
+ */
+char *Population::append(void)
+{
+    if (count == room)
+    {
+        reserve(room < 8 ? 16 : room * 2);
+    } // end if (count == room)
+
+    scores[count] = 0;
+    setLineage(count, 0);
+
+    return genomes + count++ * GENOME_STRIDE;
+} // end append()
+
+/** Remove every Puzzle, keeping the storage.
+ * @pre None.
+ * @post The Population is empty; its capacity is unchanged.
+ */
+void Population::clear(void)
+{
+    count = 0;
+    scored = 0;
+} // end clear()
+
+/** Make room for a number of Puzzles without growing again.
+ * @param count  The number of Puzzles to make room for.
+ * @pre None.
+ * @post capacity() is at least count.
+ */
+void Population::reserve(size_t count)
+{
+    if (count <= room)
+    {
+        return;
+    } // end if (count <= room)
+
+    void *fresh = ArenaPool::local().allocate(footprint(count));
+    uintptr_t start = reinterpret_cast<uintptr_t>(fresh);
+    char *base = reinterpret_cast<char*>((start + ALIGNMENT - 1) &
+                                         ~(ALIGNMENT - 1));
+    char *newGenomes = base;
+    char *newSpare = newGenomes + count * GENOME_STRIDE;
+    int *newScores = reinterpret_cast<int*>(newSpare + count * GENOME_STRIDE);
+    int *newOrder = newScores + count;
+
+    if (this->count > 0)
+    {
+        memcpy(newGenomes, genomes, this->count * GENOME_STRIDE);
+        memcpy(newScores, scores, this->count * sizeof(int));
+    } // end if (this->count > 0)
+
+    if (block != NULL)
+    {
+        ArenaPool::local().deallocate(block, footprint(room));
+    } // end if (block != NULL)
+
+    genomes = newGenomes;
+    spare = newSpare;
+    scores = newScores;
+    order = newOrder;
+    block = fresh;
+    room = count;
+} // end reserve(size_t)
+
+/** Provide the number of Puzzles in the Population.
+ * @pre None.
+ * @post None.
+ * @return The number of Puzzles.
+ */
+size_t Population::size(void) const
+{
+    return count;
+} // end size()
+
+/** Provide the number of Puzzles there is room for.
+ * @pre None.
+ * @post None.
+ * @return The capacity.
+ */
+size_t Population::capacity(void) const
+{
+    return room;
+} // end capacity()
+
+/** Check whether the Population holds no Puzzles.
+ * @pre None.
+ * @post None.
+ * @return true if it is empty, false otherwise.
+ */
+bool Population::empty(void) const
+{
+    return count == 0;
+} // end empty()
+
+/** Build a copy of the first Puzzle, the best after deleteWorst().
+ * @pre The Population is not empty.
+ * @post None.
+ * @return The Puzzle.
+ */
+Puzzle Population::front(void) const
+{
+    return *begin();
+} // end front()
+
+/** Provide an iterator to the first Puzzle.
+ * @pre None.
+ * @post None.
+ * @return An iterator to the first Puzzle.
+ */
+Population::const_iterator Population::begin(void) const
+{
+    return const_iterator(this, 0);
+} // end begin()
+
+/** Provide an iterator past the last Puzzle.
+ * @pre None.
+ * @post None.
+ * @return An iterator past the last Puzzle.
+ */
+Population::const_iterator Population::end(void) const
+{
+    return const_iterator(this, count);
+} // end end()
+
+/** Provide the cells of a Puzzle in place.
+ * @param index  Which Puzzle.
+ * @pre index < size().
+ * @post None.
+ * @return ROWS * COLUMNS chars, valid until the Population changes.
+ */
+const char *Population::genome(size_t index) const
+{
+    return genomes + index * GENOME_STRIDE;
+} // end genome(size_t)
+
+/** Provide the line of descent of a Puzzle, which its children share.
+ * @param index  Which Puzzle.
+ * @pre index < size().
+ * @post None.
+ * @return The lineage set for it, or 0 if none was.
+ */
+unsigned Population::lineage(size_t index) const
+{
+    uint32_t line;
+
+    memcpy(&line, genomes + index * GENOME_STRIDE + LINEAGE_OFFSET,
+           sizeof(line));
+
+    return line;
+} // end lineage(size_t)
+
+/** Set the line of descent of a Puzzle. It moves with the Puzzle through
+ *  selection, but is not part of a Puzzle copied out.
+ * @param index  Which Puzzle.
+ * @param line  Its lineage; 0 for none.
+ * @pre index < size().
+ * @post lineage(index) is line.
+ */
+void Population::setLineage(size_t index, unsigned line)
+{
+    uint32_t value = line;
+
+    memcpy(genomes + index * GENOME_STRIDE + LINEAGE_OFFSET, &value,
+           sizeof(value));
+} // end setLineage(size_t, unsigned)
+
+/** Score Puzzles with an evaluator from now on.
+ * @param evaluator  An evaluator built for the puzzle every Puzzle here
+ *                   derives from, or NULL to score as Puzzle::fitnessOf()
+ *                   does. It is not owned and must outlast its use.
+ * @pre None.
+ * @post Later scoring uses evaluator. The cutoff counters are zero.
+ */
+void Population::scoreWith(const FitnessEvaluator *evaluator)
+{
+    this->evaluator = evaluator;
+    cutoffs.scored = cutoffs.culled = 0;
+    cutoffs.checksMade = cutoffs.checksSkipped = 0;
+} // end scoreWith(FitnessEvaluator*)
+
+/** Score the first Puzzle not yet scored, so that deleteWorst() need not.
+ * @param cutoff  The least fitness that could survive the next
+ *                deleteWorst(); a Puzzle sure to fall below it may be
+ *                scored CULLED instead.
+ * @pre Some Puzzle added since the last deleteWorst() is not yet scored.
+ * @post That Puzzle's score is kept.
+ * @return Its fitness, or CULLED.
+ */
+int Population::scoreNext(int cutoff)
+{
+    scores[scored] = rate(scored, cutoff);
+
+    return scores[scored++];
+} // end scoreNext(int)
+
+/** Provide the fitness of a Puzzle as found by the last deleteWorst() or
+ *  scoreNext().
+ * @param index  Which Puzzle.
+ * @pre index < size(), and it has been scored since it was added.
+ * @post None.
+ * @return Its fitness.
+ */
+int Population::score(size_t index) const
+{
+    return scores[index];
+} // end score(size_t)
+
+/** Provide the work saved by scoring against cutoffs.
+ * @pre None.
+ * @post None.
+ * @return The counters since the last call to scoreWith().
+ */
+const CutoffCounters& Population::cutoffCounts(void) const
+{
+    return cutoffs;
+} // end cutoffCounts()
+
+/** Provide the bytes of storage needed to hold a number of Puzzles.
+ * @param count  The number of Puzzles.
+ * @pre None.
+ * @post None.
+ * @return The bytes reserve(count) would take.
+ */
+size_t Population::footprint(size_t count)
+{
+    return count * (2 * GENOME_STRIDE + 2 * sizeof(int)) + ALIGNMENT;
+} // end footprint(size_t)
+
+/** Remove all but the Puzzles with the highest fitness. Ties go to the earlier
+ *  Puzzle, so the survivors do not depend on the scores of those culled. If a
+ *  Puzzle of perfect fitness is found, scoring stops there and it alone is
+ *  kept.
+ * @param keep  The number of Puzzles to keep, at least 1.
  * @pre None.
  * @post None.
  * @return The fitness of the Puzzle at the head of the Population.
  */
-int Population::deleteWorst(void)
+int Population::deleteWorst(size_t keep)
 {
-    int limit = size() / 10;
+    size_t candidates = 0;
+    ByScore byScore = { scores };
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i >= scored)
+        {
+            scores[i] = rate(i, CULLED);
+        } // end if (i >= scored)
+
+        // Nothing can beat it, so neither the rest nor the sort matter.
+        if (scores[i] == PERFECT)
+        {
+            memmove(genomes, genome(i), GENOME_STRIDE);
+            scores[0] = PERFECT;
+            count = scored = 1;
+            bestFitness = PERFECT;
+
+            return bestFitness;
+        } // end if (scores[i] == PERFECT)
 
-    sort(begin(), begin() + size() - 1);
+        // The last Puzzle has never been a candidate; culled ones cannot be.
+        if (i + 1 < count && scores[i] != CULLED)
+        {
+            order[candidates++] = i;
+        } // end if (i + 1 < count && scores[i] != CULLED)
+    } // end for (size_t i = 0; i < count; ++i)
 
-    for (int i = size(); i > limit; --i)
+    // Sorting indexes by score orders the Puzzles as operator< would, ties
+    // aside. Every survivor of the last generation is a candidate, so there
+    // are always enough.
     {
-        pop_back();
-    } // end for (int i = size(); i > limit; --i)
+        PROFILE_SCOPE(PROFILE_SORT);
 
-    bestFitness = front().fitness();
+        sort(order, order + candidates, byScore);
+    }
+
+    int limit = (int)min(keep, candidates);
+
+    // Gather the survivors at the front of the spare block. Each index in
+    // order is read once, so its slot can hold the survivor's score.
+    for (int i = 0; i < limit; ++i)
+    {
+        memcpy(spare + i * GENOME_STRIDE, genome(order[i]), GENOME_STRIDE);
+        order[i] = scores[order[i]];
+    } // end for (int i = 0; i < limit; ++i)
+
+    for (int i = 0; i < limit; ++i)
+    {
+        scores[i] = order[i];
+    } // end for (int i = 0; i < limit; ++i)
+
+    swap(genomes, spare);
+    count = scored = limit;
+    bestFitness = scores[0];
 
     return bestFitness;
-} // end deleteWorst(void)
+} // end deleteWorst(size_t)
+
+/** Calculate the fitness of a Puzzle.
+ * @param index  Which Puzzle.
+ * @param cutoff  The least fitness of any use, or CULLED for a full score.
+ * @pre index < size().
+ * @post The cutoff counters include this score.
+ * @return Its fitness, or CULLED if it falls below cutoff.
+ */
+int Population::rate(size_t index, int cutoff)
+{
+    if (evaluator != NULL)
+    {
+        return evaluator->fitness(genome(index), cutoff, cutoffs);
+    } // end if (evaluator != NULL)
+
+    return Puzzle::fitnessOf(genome(index));
+} // end rate(size_t, int)
@@ -1,6 +1,10 @@
 /**
  * @file    Population.h
- * @brief   Stores a populations of Puzzles to be tested as solutions.
+ * @brief   Stores a populations of Puzzles to be tested as solutions. The
+ *          cells of every Puzzle are kept together in one aligned block, and
+ *          their fitness in a parallel array of ints, so that scoring a
+ *          generation walks memory in order and selection sorts only an
+ *          array of indexes. Puzzles are copied in and out by value.
  * @author  Brendan Sweeney, SID 1161837
  * @date    November 22, 2011
  */
@@ -9,17 +13,87 @@
 #define	_POPULATION_H
 
 #include <algorithm>
-#include <vector>
+#include <cstddef>
+#include <iterator>
 
+#include "Arena.h"
+#include "FitnessEvaluator.h"
 #include "Puzzle.h"
 
 using namespace std;
 
+const int GENOME_STRIDE = 96;   // bytes per Puzzle, ROWS * COLUMNS padded
+const int LINEAGE_OFFSET = 84;  // where in the padding a lineage is kept
 
-class Population : public vector<Puzzle>
+
+/** Storage comes from the calling thread's ArenaPool, so a Population that is
+ *  freed leaves its buffers for the next one built on the same thread.
+ */
+class Population
 {
 public:
 
+    /** Steps through the Puzzles of a Population in order, yielding copies.
+     */
+    class const_iterator
+    {
+    public:
+
+        typedef input_iterator_tag iterator_category;
+        typedef Puzzle value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const Puzzle *pointer;
+        typedef Puzzle reference;
+
+        /** Default constructor.
+         */
+        const_iterator();
+
+        /** Constructor.
+         * @param aPopulation  The Population to iterate through.
+         * @param index  Initial index in the Population.
+         */
+        const_iterator(const Population *aPopulation, size_t index);
+
+        /** Build a copy of the Puzzle at which this iterator points.
+         * @pre This iterator points at a Puzzle of its Population.
+         * @post None.
+         * @return The Puzzle.
+         */
+        Puzzle operator*(void) const;
+
+        /** Move this iterator to the next Puzzle.
+         * @pre None.
+         * @post This iterator points one Puzzle further on.
+         * @return This iterator.
+         */
+        const_iterator& operator++(void);
+
+        /** Compares this iterator with another for equality.
+         * @param rhs  The iterator with which to compare.
+         * @pre None.
+         * @post None.
+         * @return true if both point at the same place, false otherwise.
+         */
+        bool operator==(const const_iterator& rhs) const;
+
+        /** Compares this iterator with another for inequality.
+         * @param rhs  The iterator with which to compare.
+         * @pre None.
+         * @post None.
+         * @return true if they point at different places, false otherwise.
+         */
+        bool operator!=(const const_iterator& rhs) const;
+
+    private:
+
+        const Population *container;
+        size_t cur;
+
+    };
+
+    typedef const_iterator iterator;
+
     /** Default constructor.
      */
     Population();
@@ -33,17 +107,212 @@ public:
      */
     virtual ~Population();
 
-    /** Remove the 90% of the population with the lowest fitness.
+    /** Assign an existing Population's Puzzles to this object.
+     * @param rhs  The Population with the values to be assigned.
+     * @pre None.
+     * @post This object is a duplicate of rhs. rhs is unchanged.
+     */
+    void operator=(const Population& rhs);
+
+    /** Add a Puzzle at the end of the Population.
+     * @param item  The Puzzle to add.
+     * @pre None.
+     * @post The Population holds a copy of item at its end.
+     */
+    void push_back(const Puzzle& item);
+
+    /** Put a Puzzle in place of another, such as a child not yet selected.
+     *  If the one replaced was scored, the new one is scored in full in its
+     *  place, so that deleteWorst() judges it on its own fitness.
+     * @param index  Which Puzzle to replace.
+     * @param item  The Puzzle to put there.
+     * @pre index < size().
+     * @post The Population holds a copy of item at index, of no lineage.
+     */
+    void replace(size_t index, const Puzzle& item);
+
+    /** Add a Puzzle at the end of the Population, to be filled in place.
+     * @pre None.
+     * @post The Population holds one more Puzzle, whose cells are not set,
+     *       of no lineage.
+     * @return Its ROWS * COLUMNS cells, valid until the Population changes.
+     */
+    char *append(void);
+
+    /** Replace every Puzzle with those in a range.
+     * @param first  The first Puzzle of the range.
+     * @param last  One past the last Puzzle of the range.
+     * @pre None.
+     * @post The Population holds copies of the Puzzles in the range, in order.
+     */
+    template <class InputIterator>
+    void assign(InputIterator first, InputIterator last)
+    {
+        clear();
+
+        for (; first != last; ++first)
+        {
+            push_back(*first);
+        } // end for (; first != last; ++first)
+    } // end assign(InputIterator, InputIterator)
+
+    /** Remove every Puzzle, keeping the storage.
+     * @pre None.
+     * @post The Population is empty; its capacity is unchanged.
+     */
+    void clear(void);
+
+    /** Make room for a number of Puzzles without growing again.
+     * @param count  The number of Puzzles to make room for.
+     * @pre None.
+     * @post capacity() is at least count.
+     */
+    void reserve(size_t count);
+
+    /** Provide the number of Puzzles in the Population.
+     * @pre None.
+     * @post None.
+     * @return The number of Puzzles.
+     */
+    size_t size(void) const;
+
+    /** Provide the number of Puzzles there is room for.
+     * @pre None.
+     * @post None.
+     * @return The capacity.
+     */
+    size_t capacity(void) const;
+
+    /** Check whether the Population holds no Puzzles.
+     * @pre None.
+     * @post None.
+     * @return true if it is empty, false otherwise.
+     */
+    bool empty(void) const;
+
+    /** Build a copy of the first Puzzle, the best after deleteWorst().
+     * @pre The Population is not empty.
+     * @post None.
+     * @return The Puzzle.
+     */
+    Puzzle front(void) const;
+
+    /** Provide an iterator to the first Puzzle.
+     * @pre None.
+     * @post None.
+     * @return An iterator to the first Puzzle.
+     */
+    const_iterator begin(void) const;
+
+    /** Provide an iterator past the last Puzzle.
+     * @pre None.
+     * @post None.
+     * @return An iterator past the last Puzzle.
+     */
+    const_iterator end(void) const;
+
+    /** Provide the cells of a Puzzle in place.
+     * @param index  Which Puzzle.
+     * @pre index < size().
+     * @post None.
+     * @return ROWS * COLUMNS chars, valid until the Population changes.
+     */
+    const char *genome(size_t index) const;
+
+    /** Provide the line of descent of a Puzzle, which its children share.
+     * @param index  Which Puzzle.
+     * @pre index < size().
+     * @post None.
+     * @return The lineage set for it, or 0 if none was.
+     */
+    unsigned lineage(size_t index) const;
+
+    /** Set the line of descent of a Puzzle. It moves with the Puzzle through
+     *  selection, but is not part of a Puzzle copied out.
+     * @param index  Which Puzzle.
+     * @param line  Its lineage; 0 for none.
+     * @pre index < size().
+     * @post lineage(index) is line.
+     */
+    void setLineage(size_t index, unsigned line);
+
+    /** Score Puzzles with an evaluator from now on.
+     * @param evaluator  An evaluator built for the puzzle every Puzzle here
+     *                   derives from, or NULL to score as Puzzle::fitnessOf()
+     *                   does. It is not owned and must outlast its use.
+     * @pre None.
+     * @post Later scoring uses evaluator. The cutoff counters are zero.
+     */
+    void scoreWith(const FitnessEvaluator *evaluator);
+
+    /** Score the first Puzzle not yet scored, so that deleteWorst() need not.
+     * @param cutoff  The least fitness that could survive the next
+     *                deleteWorst(); a Puzzle sure to fall below it may be
+     *                scored CULLED instead.
+     * @pre Some Puzzle added since the last deleteWorst() is not yet scored.
+     * @post That Puzzle's score is kept.
+     * @return Its fitness, or CULLED.
+     */
+    int scoreNext(int cutoff);
+
+    /** Provide the fitness of a Puzzle as found by the last deleteWorst() or
+     *  scoreNext().
+     * @param index  Which Puzzle.
+     * @pre index < size(), and it has been scored since it was added.
+     * @post None.
+     * @return Its fitness.
+     */
+    int score(size_t index) const;
+
+    /** Provide the work saved by scoring against cutoffs.
+     * @pre None.
+     * @post None.
+     * @return The counters since the last call to scoreWith().
+     */
+    const CutoffCounters& cutoffCounts(void) const;
+
+    /** Provide the bytes of storage needed to hold a number of Puzzles.
+     * @param count  The number of Puzzles.
+     * @pre None.
+     * @post None.
+     * @return The bytes reserve(count) would take.
+     */
+    static size_t footprint(size_t count);
+
+    /** Remove all but the Puzzles with the highest fitness. Ties go to the
+     *  earlier Puzzle, so the survivors do not depend on the scores of those
+     *  culled. If a Puzzle of perfect fitness is found, scoring stops there
+     *  and it alone is kept.
+     * @param keep  The number of Puzzles to keep, at least 1.
      * @pre None.
      * @post None.
      * @return The fitness of the Puzzle at the head of the Population.
      */
-    int deleteWorst(void);
+    int deleteWorst(size_t keep);
 
 private:
 
+    char *genomes;          // room * GENOME_STRIDE bytes, 64-byte aligned
+    char *spare;            // the same again; survivors are gathered here
+    int *scores;            // fitness, parallel to genomes
+    int *order;             // indexes of genomes, sorted by deleteWorst()
+    void *block;            // everything above, in one arena allocation
+    size_t count;
+    size_t room;
+    size_t scored;          // genomes at the front whose scores are current
+    const FitnessEvaluator *evaluator;  // NULL for Puzzle::fitnessOf()
+    CutoffCounters cutoffs;
     int bestFitness;
 
+    /** Calculate the fitness of a Puzzle.
+     * @param index  Which Puzzle.
+     * @param cutoff  The least fitness of any use, or CULLED for a full score.
+     * @pre index < size().
+     * @post The cutoff counters include this score.
+     * @return Its fitness, or CULLED if it falls below cutoff.
+     */
+    int rate(size_t index, int cutoff);
+
 };
 
 #endif	/* _POPULATION_H */
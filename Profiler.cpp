@@ -0,0 +1,250 @@
+/**
+ * @file    Profiler.cpp
+ * @brief   Timers and counters at the places where the solver spends its
+ *          time: scoring, mutating and sorting Puzzles. They are compiled
+ *          in only when SUDOKU_PROFILE is defined; otherwise the PROFILE_
+ *          macros expand to nothing and cost nothing. A profiled run can also
+ *          write a Chrome trace-event file, with one span per generation,
+ *          the running totals of every counter and any other counter tracks
+ *          added to it, to be opened in chrome://tracing or Perfetto.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#include "Profiler.h"
+
+static const char *NAMES[SITES] = { "fitness", "mutate", "sort" };
+static atomic<int> threadsSeen(0);      // for numbering threads in traces
+
+
+/** Provide a small number for the calling thread, for trace events.
+ * @pre None.
+ * @post None.
+ * @return 1 for the first thread to ask, 2 for the next, and so on.
+ */
+static int threadNumber(void)
+{
+    static thread_local int number = ++threadsSeen;
+
+    return number;
+} // end threadNumber()
+
+
+/** Provide the one Profiler shared by every thread.
+ * @pre None.
+ * @post None.
+ * @return The Profiler.
+ */
+Profiler& Profiler::global(void)
+{
+    static Profiler only;
+
+    return only;
+} // end global()
+
+/** Tell whether the PROFILE_ hooks were compiled in.
+ * @pre None.
+ * @post None.
+ * @return true in a build with SUDOKU_PROFILE defined, false otherwise.
+ */
+bool Profiler::compiledIn(void)
+{
+#ifdef SUDOKU_PROFILE
+    return true;
+#else
+    return false;
+#endif
+} // end compiledIn()
+
+/** Default constructor.
+ */
+Profiler::Profiler() : started(Clock::now()), traceLock(), trace(NULL),
+                       firstEvent(true)
+{
+    for (int i = 0; i < SITES; ++i)
+    {
+        calls[i] = 0;
+        nanos[i] = 0;
+    } // end for (int i = 0; i < SITES; ++i)
+} // end default constructor
+
+/** Destructor. Finishes the trace, if one is open.
+ */
+Profiler::~Profiler()
+{
+    closeTrace();
+} // end destructor
+
+/** Count one visit to a site, and the time it took.
+ * @param site  The site.
+ * @param nanos  The time spent, in nanoseconds.
+ * @pre None.
+ * @post None.
+ */
+void Profiler::add(ProfileSite site, long nanos)
+{
+    calls[site].fetch_add(1, memory_order_relaxed);
+    this->nanos[site].fetch_add(nanos, memory_order_relaxed);
+} // end add(ProfileSite, long)
+
+/** Mark the end of a generation on the calling thread. If a trace is open, a
+ *  span from the previous mark on this thread is written, along with the
+ *  totals of every site.
+ * @param generation  The generation just finished; 0 only sets the mark.
+ * @param best  The best fitness after it.
+ * @pre None.
+ * @post None.
+ */
+void Profiler::generation(int generation, int best)
+{
+    static thread_local Clock::time_point mark;
+    Clock::time_point now = Clock::now();
+    Clock::time_point since = mark;
+
+    mark = now;
+
+    if (generation == 0)
+    {
+        return;
+    } // end if (generation == 0)
+
+    lock_guard<mutex> guard(traceLock);
+
+    if (trace == NULL)
+    {
+        return;
+    } // end if (trace == NULL)
+
+    long long start = chrono::duration_cast<chrono::microseconds>(
+                          since - started).count();
+    long long length = chrono::duration_cast<chrono::microseconds>(
+                           now - since).count();
+
+    fprintf(trace, "%s{\"name\":\"generation\",\"ph\":\"X\",\"pid\":1,"
+            "\"tid\":%d,\"ts\":%lld,\"dur\":%lld,"
+            "\"args\":{\"generation\":%d,\"best\":%d}}",
+            firstEvent ? "" : ",\n", threadNumber(), start, length,
+            generation, best);
+    firstEvent = false;
+
+    for (int i = 0; i < SITES; ++i)
+    {
+        fprintf(trace, ",\n{\"name\":\"%s\",\"ph\":\"C\",\"pid\":1,"
+                "\"ts\":%lld,\"args\":{\"calls\":%ld,\"ms\":%.3f}}",
+                NAMES[i], start + length, calls[i].load(),
+                nanos[i].load() / 1e6);
+    } // end for (int i = 0; i < SITES; ++i)
+} // end generation(int, int)
+
+/** Write a counter event with several series to the trace, if one is open,
+ *  stamped with the current time.
+ * @param name  The name of the counter track.
+ * @param keys  The name of each series.
+ * @param values  The value of each series.
+ * @param count  The number of series.
+ * @pre None.
+ * @post None.
+ */
+void Profiler::counter(const char *name, const char *const *keys,
+                       const double *values, int count)
+{
+    Clock::time_point now = Clock::now();
+    lock_guard<mutex> guard(traceLock);
+
+    if (trace == NULL)
+    {
+        return;
+    } // end if (trace == NULL)
+
+    fprintf(trace, "%s{\"name\":\"%s\",\"ph\":\"C\",\"pid\":1,"
+            "\"ts\":%lld,\"args\":{", firstEvent ? "" : ",\n", name,
+            static_cast<long long>(chrono::duration_cast<
+                chrono::microseconds>(now - started).count()));
+    firstEvent = false;
+
+    for (int i = 0; i < count; ++i)
+    {
+        fprintf(trace, "%s\"%s\":%g", i == 0 ? "" : ",", keys[i], values[i]);
+    } // end for (int i = 0; i < count; ++i)
+
+    fputs("}}", trace);
+} // end counter(char*, char**, double*, int)
+
+/** Tell whether a trace is open, so that figures costly to gather for it can
+ *  be skipped when none is.
+ * @pre None.
+ * @post None.
+ * @return true if a trace is open, false otherwise.
+ */
+bool Profiler::tracing(void)
+{
+    lock_guard<mutex> guard(traceLock);
+
+    return trace != NULL;
+} // end tracing()
+
+/** Write a trace of every later generation to a file.
+ * @param path  The file to write.
+ * @pre None.
+ * @post On success, a trace is open; a trace already open is finished.
+ * @return true if the file was opened, false otherwise.
+ */
+bool Profiler::traceTo(const string& path)
+{
+    FILE *file = fopen(path.c_str(), "w");
+
+    if (file == NULL)
+    {
+        return false;
+    } // end if (file == NULL)
+
+    closeTrace();
+
+    lock_guard<mutex> guard(traceLock);
+
+    trace = file;
+    firstEvent = true;
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", trace);
+
+    return true;
+} // end traceTo(string&)
+
+/** Finish the trace, if one is open.
+ * @pre None.
+ * @post The trace file is complete and closed.
+ */
+void Profiler::closeTrace(void)
+{
+    lock_guard<mutex> guard(traceLock);
+
+    if (trace != NULL)
+    {
+        fputs("\n]}\n", trace);
+        fclose(trace);
+        trace = NULL;
+    } // end if (trace != NULL)
+} // end closeTrace()
+
+/** Write a table of calls and time for every site.
+ * @param out  The stream to write to.
+ * @pre None.
+ * @post None.
+ */
+void Profiler::report(ostream& out) const
+{
+    char line[128];
+
+    snprintf(line, sizeof(line), "%-10s %14s %12s %10s\n", "site", "calls",
+             "total ms", "mean ns");
+    out << line;
+
+    for (int i = 0; i < SITES; ++i)
+    {
+        long count = calls[i], spent = nanos[i];
+
+        snprintf(line, sizeof(line), "%-10s %14ld %12.1f %10.1f\n", NAMES[i],
+                 count, spent / 1e6,
+                 count > 0 ? static_cast<double>(spent) / count : 0.0);
+        out << line;
+    } // end for (int i = 0; i < SITES; ++i)
+} // end report(ostream&)
@@ -0,0 +1,181 @@
+/**
+ * @file    Profiler.h
+ * @brief   Timers and counters at the places where the solver spends its
+ *          time: scoring, mutating and sorting Puzzles. They are compiled
+ *          in only when SUDOKU_PROFILE is defined; otherwise the PROFILE_
+ *          macros expand to nothing and cost nothing. A profiled run can also
+ *          write a Chrome trace-event file, with one span per generation,
+ *          the running totals of every counter and any other counter tracks
+ *          added to it, to be opened in chrome://tracing or Perfetto.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#ifndef _PROFILER_H
+#define	_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <string>
+
+using namespace std;
+
+
+/** The places that are measured.
+ */
+enum ProfileSite
+{
+    PROFILE_FITNESS,        // Puzzle::fitnessOf() and
+                            // FitnessEvaluator::fitness(), timed
+    PROFILE_MUTATE,         // GeneticAlgorithm::mutateCells(), timed
+    PROFILE_SORT,           // the sort in Population::deleteWorst(), timed
+    SITES
+};
+
+
+class Profiler
+{
+public:
+
+    typedef chrono::steady_clock Clock;
+
+    /** Provide the one Profiler shared by every thread.
+     * @pre None.
+     * @post None.
+     * @return The Profiler.
+     */
+    static Profiler& global(void);
+
+    /** Tell whether the PROFILE_ hooks were compiled in.
+     * @pre None.
+     * @post None.
+     * @return true in a build with SUDOKU_PROFILE defined, false otherwise.
+     */
+    static bool compiledIn(void);
+
+    /** Destructor. Finishes the trace, if one is open.
+     */
+    virtual ~Profiler();
+
+    /** Count one visit to a site, and the time it took.
+     * @param site  The site.
+     * @param nanos  The time spent, in nanoseconds.
+     * @pre None.
+     * @post None.
+     */
+    void add(ProfileSite site, long nanos);
+
+    /** Mark the end of a generation on the calling thread. If a trace is open,
+     *  a span from the previous mark on this thread is written, along with
+     *  the totals of every site.
+     * @param generation  The generation just finished; 0 only sets the mark.
+     * @param best  The best fitness after it.
+     * @pre None.
+     * @post None.
+     */
+    void generation(int generation, int best);
+
+    /** Write a counter event with several series to the trace, if one is
+     *  open, stamped with the current time.
+     * @param name  The name of the counter track.
+     * @param keys  The name of each series.
+     * @param values  The value of each series.
+     * @param count  The number of series.
+     * @pre None.
+     * @post None.
+     */
+    void counter(const char *name, const char *const *keys,
+                 const double *values, int count);
+
+    /** Tell whether a trace is open, so that figures costly to gather for
+     *  it can be skipped when none is.
+     * @pre None.
+     * @post None.
+     * @return true if a trace is open, false otherwise.
+     */
+    bool tracing(void);
+
+    /** Write a trace of every later generation to a file.
+     * @param path  The file to write.
+     * @pre None.
+     * @post On success, a trace is open; a trace already open is finished.
+     * @return true if the file was opened, false otherwise.
+     */
+    bool traceTo(const string& path);
+
+    /** Finish the trace, if one is open.
+     * @pre None.
+     * @post The trace file is complete and closed.
+     */
+    void closeTrace(void);
+
+    /** Write a table of calls and time for every site.
+     * @param out  The stream to write to.
+     * @pre None.
+     * @post None.
+     */
+    void report(ostream& out) const;
+
+private:
+
+    atomic<long> calls[SITES];
+    atomic<long> nanos[SITES];
+    Clock::time_point started;  // trace times are relative to this
+    mutex traceLock;            // guards trace and firstEvent
+    FILE *trace;
+    bool firstEvent;
+
+    /** Default constructor.
+     */
+    Profiler();
+
+    // Not copyable; there is one.
+    Profiler(const Profiler& orig);
+    void operator=(const Profiler& rhs);
+
+};
+
+
+/** Times the scope it lives in and adds it to a site.
+ */
+class ScopedTimer
+{
+public:
+
+    /** Constructor. Starts the clock.
+     * @param site  The site to charge.
+     */
+    explicit ScopedTimer(ProfileSite site) : where(site),
+                                             began(Profiler::Clock::now())
+    {
+    } // end constructor
+
+    /** Destructor. Stops the clock and charges the site.
+     */
+    ~ScopedTimer()
+    {
+        Profiler::global().add(where, chrono::duration_cast<
+            chrono::nanoseconds>(Profiler::Clock::now() - began).count());
+    } // end destructor
+
+private:
+
+    ProfileSite where;
+    Profiler::Clock::time_point began;
+
+};
+
+
+#ifdef SUDOKU_PROFILE
+#define PROFILE_SCOPE(site) ScopedTimer profileScope(site)
+#define PROFILE_GENERATION(number, fitness) \
+    Profiler::global().generation(number, fitness)
+#else
+#define PROFILE_SCOPE(site)
+#define PROFILE_GENERATION(number, fitness)
+#endif
+
+#endif	/* _PROFILER_H */
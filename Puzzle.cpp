@@ -8,19 +8,28 @@
  *          nonet (a 3x3 block that is unique and does not overlap another 3x3
  *          block, so there are nine in the puzzle). This class does not solve
  *          a given puzzle, but it does have methods to determine the fitness
- *          of a given solution. This class also cannot validate a puzzle, so
- *          it is up to the user to input a solvable puzzle with only one
- *          solution. The expected initialization puzzle will be unsolved, but
- *          a puzzle with a tentative solution may also be provided. The cells
- *          that are part of the initial puzzle are marked as such to keep them
- *          separete from cells that are part of a solution. Values of char '0'
- *          represent an empty cell.
+ *          of a given solution. This class also cannot validate a puzzle; that
+ *          is done by SolutionCounter::check() before solving, if asked. The
+ *          expected initialization puzzle will be unsolved, but a puzzle with
+ *          a tentative solution may also be provided. The cells that are part
+ *          of the initial puzzle are marked as such to keep them separete from
+ *          cells that are part of a solution. Values of char '0' represent an
+ *          empty cell.
  * @author  Brendan Sweeney, SID 1161837
  * @date    November 22, 2011
  */
 
+#include <cstring>
+#include <type_traits>
+
+#include "Profiler.h"
 #include "Puzzle.h"
 
+// Puzzles are copied and moved as plain bytes throughout the solver.
+static_assert(is_trivially_copyable<Puzzle>::value &&
+              is_nothrow_move_constructible<Puzzle>::value,
+              "Puzzle must be a trivially copyable value type");
+
 
 /** Default constructor.
  */
@@ -38,32 +47,6 @@ Puzzle::PuzzleIterator::PuzzleIterator(const Puzzle *aPuzzle, int index) :
 {
 } // end constructor
 
-/** Copy constructor.
- * @param orig  The PuzzleIterator to copy.
- */
-Puzzle::PuzzleIterator::PuzzleIterator(const PuzzleIterator& orig) :
-                          container(orig.container), cur(orig.cur)
-{
-} // end copy constructor
-
-/** Destructor.
- */
-Puzzle::PuzzleIterator::~PuzzleIterator()
-{
-    container = NULL;
-} // end destructor
-
-/** Assign an existing PuzzleIterator's values to this object.
- * @param rhs  The PuzzleIterator with the values to be assigned.
- * @pre None
- * @post This object is a duplicate of rhs. rhs is unchanged
- */
-void Puzzle::PuzzleIterator::operator=(const PuzzleIterator& rhs)
-{
-    container = rhs.container;
-    cur = rhs.cur;
-} // end operator=(PuzzleIterator& orig)
-
 /** Obtain a reference to the item at which this iterator points to.
  * @pre The index of this iterator is within the range of the containing item.
  *      The item at the specified index has been set to a proper value.
@@ -207,40 +190,6 @@ Puzzle::Puzzle() : fitLevel(ROWS * COLUMNS + 1), notSet(ROWS * COLUMNS)
     } // end for (int i = 0; i < ROWS * COLUMNS; ++i)
 } // end default constructor
 
-/** Copy constructor.
- * @param orig  The Puzzle to copy.
- */
-Puzzle::Puzzle(const Puzzle& orig) : fitLevel(orig.fitLevel),
-                                         notSet(orig.notSet)
-{
-    for (int i = 0; i < ROWS * COLUMNS; ++i)
-    {
-        content[i] = orig.content[i];
-    } // end for (int i = 0; i < ROWS * COLUMNS; ++i)
-} // end copy constructor
-
-/** Destructor.
- */
-Puzzle::~Puzzle()
-{
-} // end destructor
-
-/** Assign an existing Puzzle's values to this object.
- * @param rhs  The Puzzle with the values to be assigned.
- * @pre None
- * @post This object is a duplicate of rhs. rhs is unchanged
- */
-void Puzzle::operator=(const Puzzle& rhs)
-{
-    for (int i = 0; i < ROWS * COLUMNS; ++i)
-    {
-        content[i] = rhs.content[i];
-    } // end for (int i = 0; i < ROWS * COLUMNS; ++i)
-
-    fitLevel = rhs.fitLevel;
-    notSet = rhs.notSet;
-} // end operator=(Puzzle&)
-
 /** Pull a string representing a Puzzle from an input stream.
  * @param input  The stream containing the new puzzle string.
  * @param dest  The Puzzle to be set from the input string (this one).
@@ -260,7 +209,12 @@ istream& operator>>(istream& input, Puzzle& dest)
     // found. All non-digit characters are discarded.
     while(index < ROWS * COLUMNS)
     {
-        cin >> temp;
+        input >> temp;
+
+        if (!input)                 // ran out of input
+        {
+            break;
+        } // end if (!input)
 
         if (temp == '0')            // empty cell
         {
@@ -286,12 +240,8 @@ istream& operator>>(istream& input, Puzzle& dest)
  */
 ostream& operator<<(ostream& output, const Puzzle& source)
 {
-    for (int i = 0; i < ROWS * COLUMNS; ++i)
-    {
-        output << source.content[i];
-    } // end for (int i = 0; i < ROWS * COLUMNS; ++i)
-
-    return output;
+    // One call rather than one per cell; each call pays for a sentry.
+    return output.write(source.content, ROWS * COLUMNS);
 } // end Puzzle::operator<<(ostream&, Puzzle&)
 
 /** Compare the fitness of this Puzzle with the fitness of another.
@@ -357,16 +307,23 @@ bool Puzzle::operator!=(const Puzzle& rhs) const
  */
 void Puzzle::display(void) const
 {
-    // Construct one row at a time.
+    char text[ROWS * (2 * COLUMNS + 1)];
+    char *next = text;
+
+    // Construct one row at a time, then write and flush them all at once.
     for (int i = 0; i < ROWS * COLUMNS; i += COLUMNS)
     {
         for (int j = 0; j < COLUMNS; ++j)
         {
-            cout << ' ' << content[i + j];
+            *next++ = ' ';
+            *next++ = content[i + j];
         } // end for (int j = 0; j < COLUMNS; ++j)
 
-        cout << endl;
+        *next++ = '\n';
     } // end for (int i = 0; i < ROWS * COLUMNS; i += COLUMNS)
+
+    cout.write(text, sizeof(text));
+    cout.flush();
 } // end display()
 
 /** Returns the fitness of this Puzzle. Fitness is calculated by starting with
@@ -384,14 +341,27 @@ int Puzzle::fitness(void) const
         return fitLevel;
     }
     
+    return fitnessOf(content);
+} // end fitness()
+
+/** Calculate the fitness of a plain buffer of cells, as fitness() would for a
+ *  Puzzle holding them.
+ * @param cells  ROWS * COLUMNS chars, each an ASCII digit 0-9.
+ * @pre None.
+ * @post None.
+ * @return The fitness of cells as a solution, from -135 to 81.
+ */
+int Puzzle::fitnessOf(const char *cells)
+{
+    PROFILE_SCOPE(PROFILE_FITNESS);
     int quality = ROWS * COLUMNS;       // assume perfect fitness
 
-    quality = fitRow(quality);          // check for repeats in rows
-    quality = fitColumn(quality);       // check for repeats in columns
-    quality = fitNonet(quality);        // check for repeats in nonets
+    quality = fitRow(cells, quality);   // check for repeats in rows
+    quality = fitColumn(cells, quality); // check for repeats in columns
+    quality = fitNonet(cells, quality); // check for repeats in nonets
 
     return quality;
-} // end fitness()
+} // end fitnessOf(char*)
 
 /** Provide the size of this Puzzle, indicating the number of empty spaces.
  * @pre None.
@@ -434,18 +404,114 @@ Puzzle::PuzzleIterator Puzzle::end(void) const
     return PuzzleIterator (this, ROWS * COLUMNS);
 } // end Puzzle::end()
 
+/** Set this Puzzle from a plain buffer of cells.
+ * @param cells  ROWS * COLUMNS chars, each an ASCII digit 0-9.
+ * @pre None.
+ * @post If every cell was a digit, this Puzzle has been set from cells.
+ *       Otherwise, this Puzzle is unchanged.
+ * @return true if cells held a valid Puzzle, false otherwise.
+ */
+bool Puzzle::read(const char *cells)
+{
+    int empty = 0;
+
+    for (int i = 0; i < ROWS * COLUMNS; ++i)
+    {
+        if (cells[i] < '0' || cells[i] > '9')
+        {
+            return false;
+        } // end if (cells[i] < '0' || cells[i] > '9')
+
+        empty += cells[i] == '0';
+    } // end for (int i = 0; i < ROWS * COLUMNS; ++i)
+
+    for (int i = 0; i < ROWS * COLUMNS; ++i)
+    {
+        content[i] = cells[i];
+    } // end for (int i = 0; i < ROWS * COLUMNS; ++i)
+
+    notSet = empty;
+    fitLevel = ROWS * COLUMNS + 1;
+
+    return true;
+} // end read(char*)
+
+/** Copy the cells of this Puzzle into a plain buffer.
+ * @param cells  Storage for at least ROWS * COLUMNS chars. No terminating null
+ *               is written.
+ * @pre None.
+ * @post cells holds every cell of this Puzzle. This Puzzle is unchanged.
+ */
+void Puzzle::write(char *cells) const
+{
+    memcpy(cells, content, ROWS * COLUMNS);
+} // end write(char*)
+
+/** Write this Puzzle in packed form, two cells to a byte.
+ * @param dest  Storage for at least PACKED_SIZE bytes.
+ * @pre None.
+ * @post dest holds every cell of this Puzzle. This Puzzle is unchanged.
+ */
+void Puzzle::pack(unsigned char *dest) const
+{
+    for (int i = 0; i < ROWS * COLUMNS; i += 2)
+    {
+        unsigned char low = content[i] - '0';
+        unsigned char high = i + 1 < ROWS * COLUMNS ? content[i + 1] - '0' : 0;
+
+        dest[i / 2] = low | (high << 4);
+    } // end for (int i = 0; i < ROWS * COLUMNS; i += 2)
+} // end pack(unsigned char*)
+
+/** Set this Puzzle from the packed form written by pack().
+ * @param source  PACKED_SIZE bytes written by pack().
+ * @pre None.
+ * @post If every cell held a digit, this Puzzle has been set from source.
+ *       Otherwise, this Puzzle is unchanged.
+ * @return true if source held a valid packed Puzzle, false otherwise.
+ */
+bool Puzzle::unpack(const unsigned char *source)
+{
+    char cells[ROWS * COLUMNS];
+    int empty = 0;
+
+    for (int i = 0; i < ROWS * COLUMNS; ++i)
+    {
+        unsigned char digit = (source[i / 2] >> ((i % 2) * 4)) & 0x0F;
+
+        if (digit > 9)
+        {
+            return false;
+        } // end if (digit > 9)
+
+        cells[i] = '0' + digit;
+        empty += digit == 0;
+    } // end for (int i = 0; i < ROWS * COLUMNS; ++i)
+
+    for (int i = 0; i < ROWS * COLUMNS; ++i)
+    {
+        content[i] = cells[i];
+    } // end for (int i = 0; i < ROWS * COLUMNS; ++i)
+
+    notSet = empty;
+    fitLevel = ROWS * COLUMNS + 1;
+
+    return true;
+} // end unpack(unsigned char*)
+
 /** Determine the number of times rules are broken by row.
+ * @param cells  The ROWS * COLUMNS cells to check.
  * @param quality  The initial quality to work back from.
  * @pre None.
  * @post None.
  * @return The input quality minus the number of broken rules by row.
  */
-int Puzzle::fitRow(int quality) const
+int Puzzle::fitRow(const char *cells, int quality)
 {
     // check rows one-at-a-time
     for (int i = 0; i < ROWS * COLUMNS; ++i)
     {
-        if (content[i] == '0')  // empty cell
+        if (cells[i] == '0')  // empty cell
         {
             --quality;
         }
@@ -454,25 +520,26 @@ int Puzzle::fitRow(int quality) const
             // If not at end of row, check against remaining cells in row
             for (int j = i + 1; j < (i / ROWS) * COLUMNS + COLUMNS; ++j)
             { // invaraint: i and j are in the same row
-                if (content[j] == content[i])   // duplicate found
+                if (cells[j] == cells[i])   // duplicate found
                 {
                     --quality;
                     break;
-                } // end if (content[j] == content[i])
+                } // end if (cells[j] == cells[i])
             } // end for (int j = i + 1)
-        } // end if (content[i] == '0')
+        } // end if (cells[i] == '0')
     } // end for (int i = 0)
 
     return quality;
-} // end fitRow(int)
+} // end fitRow(char*, int)
 
 /** Determine the number of times rules are broken by column.
+ * @param cells  The ROWS * COLUMNS cells to check.
  * @param quality  The initial quality to work back from.
  * @pre None.
  * @post None.
  * @return The input quality minus the number of broken rules by column.
  */
-int Puzzle::fitColumn(int quality) const
+int Puzzle::fitColumn(const char *cells, int quality)
 {
     // Traverse puzzle from first cell to last cell of second-to-last row (no
     // need to check last cells against themselves)
@@ -481,31 +548,32 @@ int Puzzle::fitColumn(int quality) const
         // Check against remaining cells in column
         for (int j = i + COLUMNS; j < ROWS * COLUMNS; j += COLUMNS)
         { // invaraint: i and i + j are in the same column
-            if (content[j] == content[i] && content[i] != '0')  // dup found
+            if (cells[j] == cells[i] && cells[i] != '0')  // dup found
             {
                 --quality;
                 break;
-            } // end if (content[j] == content[i] && content[i] != '0')
+            } // end if (cells[j] == cells[i] && cells[i] != '0')
         } // end for (int j = i + COLUMNS)
     } // end for (int i = 0)
 
     return quality;
-} // end fitColumn(int)
+} // end fitColumn(char*, int)
 
 /** Determine the number of times rules are broken by nonet.
+ * @param cells  The ROWS * COLUMNS cells to check.
  * @param quality  The initial quality to work back from.
  * @pre None.
  * @post None.
  * @return The input quality minus the number of broken rules by nonet.
  */
-int Puzzle::fitNonet(int quality) const
+int Puzzle::fitNonet(const char *cells, int quality)
 {
     int temp;
     // Traverse puzzle from first cell to second-to-last (no need to check last
     // cell against itself)
     for (int i = 0; i < ROWS * COLUMNS - 1; ++i)
     {
-        if (content[i] != '0')      // 0's only counted once, use fitRow().
+        if (cells[i] != '0')      // 0's only counted once, use fitRow().
         {
             if (i % 3 > 1)          // at edge of nonet
             {
@@ -518,7 +586,7 @@ int Puzzle::fitNonet(int quality) const
 
             while(temp - i < 3 || (temp / ROWS) % 3 > (i / ROWS) % 3)
             {
-                if (content[temp] == content[i])    // duplicate found
+                if (cells[temp] == cells[i])    // duplicate found
                 {
                     --quality;
                     break;
@@ -530,9 +598,9 @@ int Puzzle::fitNonet(int quality) const
                 else
                 {
                     ++temp;
-                } // end if (content[temp] == content[i])
+                } // end if (cells[temp] == cells[i])
             } // end while(temp - i < 3 || (temp / ROWS) % 3 > (i / ROWS) % 3)
-        } // end if (content[i] != '0')
+        } // end if (cells[i] != '0')
     } // end for (int i = 0)
 
     return quality;
@@ -8,13 +8,13 @@
  *          nonet (a 3x3 block that is unique and does not overlap another 3x3
  *          block, so there are nine in the puzzle). This class does not solve
  *          a given puzzle, but it does have methods to determine the fitness
- *          of a given solution. This class also cannot validate a puzzle, so
- *          it is up to the user to input a solvable puzzle with only one
- *          solution. The expected initialization puzzle will be unsolved, but
- *          a puzzle with a tentative solution may also be provided. The cells
- *          that are part of the initial puzzle are marked as such to keep them
- *          separete from cells that are part of a solution. Values of char '0'
- *          represent an empty cell.
+ *          of a given solution. This class also cannot validate a puzzle; that
+ *          is done by SolutionCounter::check() before solving, if asked. The
+ *          expected initialization puzzle will be unsolved, but a puzzle with
+ *          a tentative solution may also be provided. The cells that are part
+ *          of the initial puzzle are marked as such to keep them separete from
+ *          cells that are part of a solution. Values of char '0' represent an
+ *          empty cell.
  * @author  Brendan Sweeney, SID 1161837
  * @date    November 22, 2011
  */
@@ -28,6 +28,7 @@ using namespace std;
 
 const int ROWS = 9;
 const int COLUMNS = 9;
+const int PACKED_SIZE = (ROWS * COLUMNS + 1) / 2;   // two cells per byte
 
 
 class Puzzle
@@ -53,21 +54,23 @@ public:
          */
         PuzzleIterator(const Puzzle *aPuzzle, int index);
 
-        /** Copy constructor.
+        /** Copy constructor. A PuzzleIterator is a pointer and an index, and
+         *  is copied as plain bytes.
          * @param orig  The PuzzleIterator to copy.
          */
-        PuzzleIterator(const PuzzleIterator& orig);
+        PuzzleIterator(const PuzzleIterator& orig) = default;
 
         /** Destructor.
          */
-        virtual ~PuzzleIterator();
+        ~PuzzleIterator() = default;
 
         /** Assign an existing PuzzleIterator's values to this object.
          * @param rhs  The PuzzleIterator with the values to be assigned.
          * @pre None
          * @post This object is a duplicate of rhs. rhs is unchanged
+         * @return This PuzzleIterator.
          */
-        void operator=(const PuzzleIterator& rhs);
+        PuzzleIterator& operator=(const PuzzleIterator& rhs) = default;
 
         /** Obtain a reference to the item at which this iterator points to.
          * @pre The index of this iterator is within the range of the
@@ -159,21 +162,38 @@ public:
     
     Puzzle();
     
-    /** Copy constructor.
+    /** Copy constructor. A Puzzle is trivially copyable: copies and moves
+     *  are a copy of its bytes, so vectors of Puzzles grow and sort by
+     *  memmove rather than cell by cell.
      * @param orig  The Puzzle to copy.
      */
-    Puzzle(const Puzzle& orig);
+    Puzzle(const Puzzle& orig) = default;
+
+    /** Move constructor. The same as a copy; it cannot throw.
+     * @param orig  The Puzzle to move.
+     */
+    Puzzle(Puzzle&& orig) noexcept = default;
     
-    /** Destructor.
+    /** Destructor. Not virtual; Puzzle is not meant to be derived from.
      */
-    virtual ~Puzzle();
+    ~Puzzle() = default;
 
     /** Assign an existing Puzzle's values to this object.
      * @param rhs  The Puzzle with the values to be assigned.
      * @pre None
      * @post This object is a duplicate of rhs. rhs is unchanged
+     * @return This Puzzle.
+     */
+    Puzzle& operator=(const Puzzle& rhs) = default;
+
+    /** Move an existing Puzzle's values to this object. The same as a copy;
+     *  it cannot throw.
+     * @param rhs  The Puzzle with the values to be moved.
+     * @pre None
+     * @post This object is a duplicate of rhs.
+     * @return This Puzzle.
      */
-    void operator=(const Puzzle& rhs);
+    Puzzle& operator=(Puzzle&& rhs) noexcept = default;
     
     /** Pull a string representing a Puzzle from an input stream.
      * @param input  The stream containing the new puzzle string.
@@ -252,6 +272,15 @@ public:
      */
     int fitness(void) const;
 
+    /** Calculate the fitness of a plain buffer of cells, as fitness() would
+     *  for a Puzzle holding them.
+     * @param cells  ROWS * COLUMNS chars, each an ASCII digit 0-9.
+     * @pre None.
+     * @post None.
+     * @return The fitness of cells as a solution, from -135 to 81.
+     */
+    static int fitnessOf(const char *cells);
+
     /** Provide the size of this Puzzle, indicating the number of empty spaces.
      * @pre None.
      * @post None.
@@ -279,6 +308,39 @@ public:
      * @return An iterator to the last item in this Puzzle.
      */
     PuzzleIterator end(void) const;
+
+    /** Set this Puzzle from a plain buffer of cells.
+     * @param cells  ROWS * COLUMNS chars, each an ASCII digit 0-9.
+     * @pre None.
+     * @post If every cell was a digit, this Puzzle has been set from cells.
+     *       Otherwise, this Puzzle is unchanged.
+     * @return true if cells held a valid Puzzle, false otherwise.
+     */
+    bool read(const char *cells);
+
+    /** Copy the cells of this Puzzle into a plain buffer.
+     * @param cells  Storage for at least ROWS * COLUMNS chars. No terminating
+     *               null is written.
+     * @pre None.
+     * @post cells holds every cell of this Puzzle. This Puzzle is unchanged.
+     */
+    void write(char *cells) const;
+
+    /** Write this Puzzle in packed form, two cells to a byte.
+     * @param dest  Storage for at least PACKED_SIZE bytes.
+     * @pre None.
+     * @post dest holds every cell of this Puzzle. This Puzzle is unchanged.
+     */
+    void pack(unsigned char *dest) const;
+
+    /** Set this Puzzle from the packed form written by pack().
+     * @param source  PACKED_SIZE bytes written by pack().
+     * @pre None.
+     * @post If every cell held a digit, this Puzzle has been set from source.
+     *       Otherwise, this Puzzle is unchanged.
+     * @return true if source held a valid packed Puzzle, false otherwise.
+     */
+    bool unpack(const unsigned char *source);
     
 private:
 
@@ -287,28 +349,31 @@ private:
     char content[ROWS * COLUMNS];
 
     /** Determine the number of times rules are broken by row.
+     * @param cells  The ROWS * COLUMNS cells to check.
      * @param quality  The initial quality to work back from.
      * @pre None.
      * @post None.
      * @return The input quality minus the number of broken rules by row.
      */
-    int fitRow(int quality) const;
+    static int fitRow(const char *cells, int quality);
 
     /** Determine the number of times rules are broken by column.
+     * @param cells  The ROWS * COLUMNS cells to check.
      * @param quality  The initial quality to work back from.
      * @pre None.
      * @post None.
      * @return The input quality minus the number of broken rules by column.
      */
-    int fitColumn(int quality) const;
+    static int fitColumn(const char *cells, int quality);
 
     /** Determine the number of times rules are broken by nonet.
+     * @param cells  The ROWS * COLUMNS cells to check.
      * @param quality  The initial quality to work back from.
      * @pre None.
      * @post None.
      * @return The input quality minus the number of broken rules by nonet.
      */
-    int fitNonet(int quality) const;
+    static int fitNonet(const char *cells, int quality);
 
 };
 
@@ -0,0 +1,169 @@
+/**
+ * @file    PuzzleGenerator.cpp
+ * @brief   Makes new puzzles with exactly one solution for benchmarking the
+ *          solver. A random complete grid is filled in, then clues are dug
+ *          out of it, in symmetric pairs by default, as long as the puzzle
+ *          still has only one solution. Puzzles are graded into difficulty
+ *          tiers by their number of clues.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#include <cstring>
+
+#include "PuzzleGenerator.h"
+
+static const char *NAMES[TIERS] = { "easy", "medium", "hard", "expert" };
+static const int MOST[TIERS] = { 45, 35, 29, 25 };     // clues, per tier
+static const int FEWEST[TIERS] = { 36, 30, 26, 22 };
+
+
+/** Constructor.
+ * @param seed  Equal seeds produce equal sequences of puzzles.
+ */
+PuzzleGenerator::PuzzleGenerator(uint64_t seed) : rng(seed), counter()
+{
+} // end constructor
+
+/** Make a puzzle with a unique solution and a given number of clues.
+ * @param clues  The number of clues wanted, 17 or more.
+ * @param symmetric  Whether clues are removed in pairs that mirror each other
+ *                   through the center, as in most published puzzles.
+ * @param puzzle  Set to the new puzzle.
+ * @pre None.
+ * @post puzzle has exactly one solution.
+ * @return true if the puzzle has the number of clues wanted (or, when
+ *         symmetric, one fewer), false if no more clues could be removed
+ *         first; the puzzle is then still unique, but has more clues.
+ */
+bool PuzzleGenerator::generate(int clues, bool symmetric, Puzzle& puzzle)
+{
+    char cells[ROWS * COLUMNS];
+    int order[ROWS * COLUMNS];
+    int cellCount = symmetric ? (ROWS * COLUMNS + 1) / 2 : ROWS * COLUMNS;
+    int remaining = ROWS * COLUMNS;
+
+    counter.fill(rng, cells);
+
+    for (int i = 0; i < cellCount; ++i)
+    {
+        order[i] = i;
+    } // end for (int i = 0; i < cellCount; ++i)
+
+    for (int i = cellCount - 1; i > 0; --i)
+    {
+        int j = rng.below(i + 1), temp = order[i];
+
+        order[i] = order[j];
+        order[j] = temp;
+    } // end for (int i = cellCount - 1; i > 0; --i)
+
+    // Dig out each cell (and its mirror) unless that leaves more than one
+    // solution.
+    for (int i = 0; i < cellCount && remaining > clues; ++i)
+    {
+        int cell = order[i], mirror = ROWS * COLUMNS - 1 - order[i];
+        char saved = cells[cell], savedMirror = cells[mirror];
+        bool paired = symmetric && mirror != cell;
+
+        cells[cell] = '0';
+        if (paired)
+        {
+            cells[mirror] = '0';
+        } // end if (paired)
+
+        if (counter.count(cells, 2) == 1)
+        {
+            remaining -= paired ? 2 : 1;
+        }
+        else
+        {
+            cells[cell] = saved;
+            cells[mirror] = savedMirror;
+        } // end if (counter.count(cells, 2) == 1)
+    } // end for (int i = 0; i < cellCount && remaining > clues; ++i)
+
+    puzzle.read(cells);
+
+    return remaining <= clues;
+} // end generate(int, bool, Puzzle&)
+
+/** Make a puzzle with a unique solution in a given tier, retrying until one
+ *  can be dug out far enough.
+ * @param tier  The difficulty wanted.
+ * @param symmetric  Whether clues are removed in mirrored pairs.
+ * @pre None.
+ * @post None.
+ * @return A puzzle with one solution whose grade() is tier.
+ */
+Puzzle PuzzleGenerator::generate(Difficulty tier, bool symmetric)
+{
+    Puzzle puzzle;
+    int clues = FEWEST[tier] + rng.below(MOST[tier] - FEWEST[tier] + 1);
+
+    // A target in the tier may still be missed by the symmetric overshoot.
+    while (!generate(clues, symmetric, puzzle) || grade(puzzle) != tier)
+    {
+        clues = FEWEST[tier] + rng.below(MOST[tier] - FEWEST[tier] + 1);
+    } // end while (!generate(clues, symmetric, puzzle) || ...)
+
+    return puzzle;
+} // end generate(Difficulty, bool)
+
+/** Grade a puzzle by its number of clues.
+ * @param puzzle  The puzzle to grade.
+ * @pre None.
+ * @post None.
+ * @return The tier of the puzzle.
+ */
+Difficulty PuzzleGenerator::grade(const Puzzle& puzzle)
+{
+    int clues = ROWS * COLUMNS - puzzle.size();
+
+    if (clues >= FEWEST[EASY])
+    {
+        return EASY;
+    }
+    else if (clues >= FEWEST[MEDIUM])
+    {
+        return MEDIUM;
+    }
+    else if (clues >= FEWEST[HARD])
+    {
+        return HARD;
+    } // end if (clues >= FEWEST[EASY])
+
+    return EXPERT;
+} // end grade(Puzzle&)
+
+/** Provide the name of a tier.
+ * @param tier  The tier.
+ * @pre tier < TIERS.
+ * @post None.
+ * @return "easy", "medium", "hard" or "expert".
+ */
+const char *PuzzleGenerator::name(Difficulty tier)
+{
+    return NAMES[tier];
+} // end name(Difficulty)
+
+/** Find a tier by name.
+ * @param text  A name returned by name().
+ * @param tier  Set to the tier, if the name is known.
+ * @pre None.
+ * @post tier is unchanged unless true is returned.
+ * @return true if text names a tier, false otherwise.
+ */
+bool PuzzleGenerator::tierNamed(const char *text, Difficulty& tier)
+{
+    for (int i = 0; i < TIERS; ++i)
+    {
+        if (strcmp(text, NAMES[i]) == 0)
+        {
+            tier = static_cast<Difficulty>(i);
+            return true;
+        } // end if (strcmp(text, NAMES[i]) == 0)
+    } // end for (int i = 0; i < TIERS; ++i)
+
+    return false;
+} // end tierNamed(char*, Difficulty&)
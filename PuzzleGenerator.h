@@ -0,0 +1,97 @@
+/**
+ * @file    PuzzleGenerator.h
+ * @brief   Makes new puzzles with exactly one solution for benchmarking the
+ *          solver. A random complete grid is filled in, then clues are dug
+ *          out of it, in symmetric pairs by default, as long as the puzzle
+ *          still has only one solution. Puzzles are graded into difficulty
+ *          tiers by their number of clues.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#ifndef _PUZZLEGENERATOR_H
+#define	_PUZZLEGENERATOR_H
+
+#include "Puzzle.h"
+#include "Random.h"
+#include "SolutionCounter.h"
+
+
+/** Difficulty tiers, from the most clues to the fewest.
+ */
+enum Difficulty
+{
+    EASY,                   // 36 or more clues
+    MEDIUM,                 // 30 to 35 clues
+    HARD,                   // 26 to 29 clues
+    EXPERT,                 // 25 or fewer clues
+    TIERS                   // the number of tiers
+};
+
+
+class PuzzleGenerator
+{
+public:
+
+    /** Constructor.
+     * @param seed  Equal seeds produce equal sequences of puzzles.
+     */
+    explicit PuzzleGenerator(uint64_t seed);
+
+    /** Make a puzzle with a unique solution and a given number of clues.
+     * @param clues  The number of clues wanted, 17 or more.
+     * @param symmetric  Whether clues are removed in pairs that mirror each
+     *                   other through the center, as in most published
+     *                   puzzles.
+     * @param puzzle  Set to the new puzzle.
+     * @pre None.
+     * @post puzzle has exactly one solution.
+     * @return true if the puzzle has the number of clues wanted (or, when
+     *         symmetric, one fewer), false if no more clues could be removed
+     *         first; the puzzle is then still unique, but has more clues.
+     */
+    bool generate(int clues, bool symmetric, Puzzle& puzzle);
+
+    /** Make a puzzle with a unique solution in a given tier, retrying until
+     *  one can be dug out far enough.
+     * @param tier  The difficulty wanted.
+     * @param symmetric  Whether clues are removed in mirrored pairs.
+     * @pre None.
+     * @post None.
+     * @return A puzzle with one solution whose grade() is tier.
+     */
+    Puzzle generate(Difficulty tier, bool symmetric);
+
+    /** Grade a puzzle by its number of clues.
+     * @param puzzle  The puzzle to grade.
+     * @pre None.
+     * @post None.
+     * @return The tier of the puzzle.
+     */
+    static Difficulty grade(const Puzzle& puzzle);
+
+    /** Provide the name of a tier.
+     * @param tier  The tier.
+     * @pre tier < TIERS.
+     * @post None.
+     * @return "easy", "medium", "hard" or "expert".
+     */
+    static const char *name(Difficulty tier);
+
+    /** Find a tier by name.
+     * @param text  A name returned by name().
+     * @param tier  Set to the tier, if the name is known.
+     * @pre None.
+     * @post tier is unchanged unless true is returned.
+     * @return true if text names a tier, false otherwise.
+     */
+    static bool tierNamed(const char *text, Difficulty& tier);
+
+private:
+
+    Random rng;
+    SolutionCounter counter;
+
+};
+
+#endif	/* _PUZZLEGENERATOR_H */
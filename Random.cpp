@@ -0,0 +1,77 @@
+/**
+ * @file    Random.cpp
+ * @brief   A small, fast pseudo-random number generator whose complete state
+ *          is a single 64-bit word, so that it can be saved and restored
+ *          exactly. Unlike rand(), each instance is independent of every
+ *          other, which keeps runs that share a process from disturbing one
+ *          another.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#include <cstdlib>
+
+#include "Random.h"
+
+
+/** Scramble a seed so that nearby seeds give unrelated sequences, and so that
+ *  the state is never 0 (xorshift cannot leave 0).
+ * @param seed  Any value.
+ * @pre None.
+ * @post None.
+ * @return A well-mixed, non-zero state.
+ */
+static uint64_t mix(uint64_t seed)
+{
+    uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+
+    return z != 0 ? z : 0x9E3779B97F4A7C15ULL;
+} // end mix(uint64_t)
+
+/** Default constructor. Seeds from rand(), so srand() should already have been
+ *  called.
+ */
+Random::Random() : word(mix((static_cast<uint64_t>(rand()) << 32) ^ rand()))
+{
+} // end default constructor
+
+/** Constructor.
+ * @param seed  Any value; equal seeds produce equal sequences.
+ */
+Random::Random(uint64_t seed) : word(mix(seed))
+{
+} // end constructor
+
+/** Constructor for one of many independent streams sharing a seed, such as
+ *  one per thread or island.
+ * @param seed  Any value; equal seeds produce equal families of streams.
+ * @param stream  Which member of the family; different streams produce
+ *                unrelated sequences.
+ */
+Random::Random(uint64_t seed, uint64_t stream) : word(mix(mix(seed) ^ stream))
+{
+} // end constructor
+
+/** Provide the complete state of this generator.
+ * @pre None.
+ * @post None.
+ * @return A value that, passed to setState(), resumes this sequence.
+ */
+uint64_t Random::state(void) const
+{
+    return word;
+} // end state()
+
+/** Restore a state previously obtained from state().
+ * @param value  The state to resume from.
+ * @pre value came from state(); it is never 0.
+ * @post The next value produced matches the saved sequence.
+ */
+void Random::setState(uint64_t value)
+{
+    word = value;
+} // end setState(uint64_t)
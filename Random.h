@@ -0,0 +1,123 @@
+/**
+ * @file    Random.h
+ * @brief   A small, fast pseudo-random number generator whose complete state
+ *          is a single 64-bit word, so that it can be saved and restored
+ *          exactly. Unlike rand(), each instance is independent of every
+ *          other, which keeps runs that share a process from disturbing one
+ *          another.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#ifndef _RANDOM_H
+#define	_RANDOM_H
+
+#include <stdint.h>
+
+
+class Random
+{
+public:
+
+    /** Default constructor. Seeds from rand(), so srand() should already
+     *  have been called.
+     */
+    Random();
+
+    /** Constructor.
+     * @param seed  Any value; equal seeds produce equal sequences.
+     */
+    explicit Random(uint64_t seed);
+
+    /** Constructor for one of many independent streams sharing a seed, such
+     *  as one per thread or island.
+     * @param seed  Any value; equal seeds produce equal families of streams.
+     * @param stream  Which member of the family; different streams produce
+     *                unrelated sequences.
+     */
+    Random(uint64_t seed, uint64_t stream);
+
+    /** Produce the next 64 random bits.
+     * @pre None.
+     * @post The state has advanced by one step.
+     * @return A uniformly distributed 64-bit value.
+     */
+    uint64_t next(void);
+
+    /** Produce a random double in the range [0, 1).
+     * @pre None.
+     * @post The state has advanced by one step.
+     * @return A uniformly distributed value from 0 up to, but not including,
+     *         1.
+     */
+    double uniform(void);
+
+    /** Produce a random integer in the range [0, bound).
+     * @param bound  One greater than the largest value wanted; must be > 0.
+     * @pre None.
+     * @post The state has advanced by one step.
+     * @return A uniformly distributed value from 0 to bound - 1.
+     */
+    unsigned below(unsigned bound);
+
+    /** Provide the complete state of this generator.
+     * @pre None.
+     * @post None.
+     * @return A value that, passed to setState(), resumes this sequence.
+     */
+    uint64_t state(void) const;
+
+    /** Restore a state previously obtained from state().
+     * @param value  The state to resume from.
+     * @pre value came from state(); it is never 0.
+     * @post The next value produced matches the saved sequence.
+     */
+    void setState(uint64_t value);
+
+private:
+
+    uint64_t word;
+
+};
+
+
+// The draws are defined here, rather than in Random.cpp, so that the loops
+// that make millions of them can have them inlined.
+
+/** Produce the next 64 random bits (xorshift64*).
+ * @pre None.
+ * @post The state has advanced by one step.
+ * @return A uniformly distributed 64-bit value.
+ */
+inline uint64_t Random::next(void)
+{
+    word ^= word >> 12;
+    word ^= word << 25;
+    word ^= word >> 27;
+
+    return word * 0x2545F4914F6CDD1DULL;
+} // end next()
+
+/** Produce a random double in the range [0, 1).
+ * @pre None.
+ * @post The state has advanced by one step.
+ * @return A uniformly distributed value from 0 up to, but not including, 1.
+ */
+inline double Random::uniform(void)
+{
+    return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+} // end uniform()
+
+/** Produce a random integer in the range [0, bound).
+ * @param bound  One greater than the largest value wanted; must be > 0.
+ * @pre None.
+ * @post The state has advanced by one step.
+ * @return A uniformly distributed value from 0 to bound - 1.
+ */
+inline unsigned Random::below(unsigned bound)
+{
+    // Multiply-shift maps 32 random bits onto [0, bound) without division.
+    return static_cast<unsigned>(((next() >> 32) * bound) >> 32);
+} // end below(unsigned)
+
+#endif	/* _RANDOM_H */
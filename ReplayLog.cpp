@@ -0,0 +1,260 @@
+/**
+ * @file    ReplayLog.cpp
+ * @brief   A compact record of the selection made in every generation of a
+ *          run, so that a run can be repeated, for example under a profiler,
+ *          and checked against the original generation by generation. Each
+ *          generation is stored as its number, its best fitness and a hash
+ *          of the Puzzles that survived selection. A log names the seed,
+ *          puzzle, population size and tuning of its run, and is checked
+ *          only against a run with all four the same.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#include <cstring>
+
+#include "GeneticAlgorithm.h"
+#include "ReplayLog.h"
+
+// File layout, in host byte order:
+//   magic[4] seed:u64 puzzle[PACKED_SIZE] popSize:i32 children:i32
+//   mutantiness:f64 survival:f64
+//   then per generation: generation:i32 best:i32 survivors:u64
+static const char MAGIC[4] = { 'S', 'G', 'R', '2' };
+static const int SEED_AT = sizeof(MAGIC);
+static const int PUZZLE_AT = SEED_AT + sizeof(uint64_t);
+static const int SIZE_AT = PUZZLE_AT + PACKED_SIZE;
+static const int TUNING_AT = SIZE_AT + sizeof(int32_t);
+static const int HEADER_SIZE = TUNING_AT + sizeof(int32_t) +
+                               2 * sizeof(double);
+
+/** One generation as it is stored.
+ */
+struct Entry
+{
+    int32_t generation;
+    int32_t best;
+    uint64_t survivors;
+};
+
+
+/** Default constructor. The log is closed.
+ */
+ReplayLog::ReplayLog() : file(NULL), checking(false), firstMismatch(0),
+                         conflict(NULL)
+{
+} // end default constructor
+
+/** Destructor. Closes the log.
+ */
+ReplayLog::~ReplayLog()
+{
+    close();
+} // end destructor
+
+/** Start a new log, replacing any file at path.
+ * @param path  The file to write.
+ * @param seed  The seed of the run being recorded.
+ * @param init  The puzzle being solved.
+ * @param popSize  The size of the first generation.
+ * @param settings  The tuning of the run.
+ * @pre None.
+ * @post Generations passed to note() are written to path.
+ * @return true if the file was opened, false otherwise.
+ */
+bool ReplayLog::record(const string& path, uint64_t seed, const Puzzle& init,
+                       int popSize, const Tuning& settings)
+{
+    unsigned char header[HEADER_SIZE];
+
+    close();
+    identify(seed, init, popSize, settings, header);
+    file = fopen(path.c_str(), "wb");
+
+    if (file != NULL && fwrite(header, HEADER_SIZE, 1, file) != 1)
+    {
+        close();
+    } // end if (file != NULL && fwrite(header, HEADER_SIZE, 1, file) != 1)
+
+    checking = false;
+    firstMismatch = 0;
+    conflict = NULL;
+
+    return file != NULL;
+} // end record(string&, uint64_t, Puzzle&, int, Tuning&)
+
+/** Open an existing log to check a repeated run against it.
+ * @param path  A file written by record().
+ * @param seed  The seed of the run being checked.
+ * @param init  The puzzle being solved.
+ * @param popSize  The size of the first generation.
+ * @param settings  The tuning of the run.
+ * @pre None.
+ * @post Generations passed to note() are compared with path. If the file was
+ *       recorded for another run, mismatch() names what differs.
+ * @return true if the file was opened and was recorded with the same seed,
+ *         puzzle, population size and tuning, false otherwise.
+ */
+bool ReplayLog::verify(const string& path, uint64_t seed, const Puzzle& init,
+                       int popSize, const Tuning& settings)
+{
+    // Each part of the header after the magic, in order, and its name.
+    static const int PART_AT[] = { SEED_AT, PUZZLE_AT, SIZE_AT, TUNING_AT,
+                                   HEADER_SIZE };
+    static const char *PART_NAME[] = { "seed", "puzzle", "population size",
+                                       "tuning" };
+    unsigned char expected[HEADER_SIZE], found[HEADER_SIZE];
+
+    close();
+    identify(seed, init, popSize, settings, expected);
+    file = fopen(path.c_str(), "rb");
+    checking = true;
+    firstMismatch = 0;
+    conflict = NULL;
+
+    if (file == NULL)
+    {
+        return false;
+    } // end if (file == NULL)
+
+    bool log = fread(found, HEADER_SIZE, 1, file) == 1 &&
+               memcmp(found, expected, SEED_AT) == 0;
+
+    for (int i = 0; log && conflict == NULL && i < 4; ++i)
+    {
+        if (memcmp(found + PART_AT[i], expected + PART_AT[i],
+                   PART_AT[i + 1] - PART_AT[i]) != 0)
+        {
+            conflict = PART_NAME[i];
+        } // end if (memcmp(...) != 0)
+    } // end for (int i = 0; log && conflict == NULL && i < 4; ++i)
+
+    if (!log || conflict != NULL)
+    {
+        fclose(file);
+        file = NULL;
+    } // end if (!log || conflict != NULL)
+
+    return file != NULL;
+} // end verify(string&, uint64_t, Puzzle&, int, Tuning&)
+
+/** Provide what set the recorded run apart from the one verify() was asked to
+ *  check.
+ * @pre None.
+ * @post None.
+ * @return "seed", "puzzle", "population size" or "tuning", the first that
+ *         differed, or NULL if the last verify() found none or could not
+ *         read a log at all.
+ */
+const char *ReplayLog::mismatch(void) const
+{
+    return conflict;
+} // end mismatch()
+
+/** Record or check the selection made in one generation.
+ * @param generation  The number of the generation, counting from 1.
+ * @param best  The best fitness after selection.
+ * @param survivors  The Population after selection.
+ * @pre The log is open.
+ * @post In recording mode, the generation is written. In checking mode, a
+ *       difference from the recorded run is remembered.
+ */
+void ReplayLog::note(int generation, int best, const Population& survivors)
+{
+    Entry entry = { generation, best, 14695981039346656037ULL };
+    Entry recorded;
+    unsigned char packed[PACKED_SIZE];
+
+    if (file == NULL)
+    {
+        return;
+    } // end if (file == NULL)
+
+    // FNV-1a over the survivors in their selected order.
+    for (Population::const_iterator it = survivors.begin();
+         it != survivors.end(); ++it)
+    {
+        (*it).pack(packed);
+
+        for (int i = 0; i < PACKED_SIZE; ++i)
+        {
+            entry.survivors = (entry.survivors ^ packed[i]) *
+                              1099511628211ULL;
+        } // end for (int i = 0; i < PACKED_SIZE; ++i)
+    } // end for (Population::const_iterator it = survivors.begin(); ...)
+
+    if (!checking)
+    {
+        fwrite(&entry, sizeof(entry), 1, file);
+    }
+    else if (firstMismatch == 0 &&
+             (fread(&recorded, sizeof(recorded), 1, file) != 1 ||
+              recorded.generation != entry.generation ||
+              recorded.best != entry.best ||
+              recorded.survivors != entry.survivors))
+    {
+        firstMismatch = generation;
+    } // end if (!checking)
+} // end note(int, int, Population&)
+
+/** Provide the first generation that differed from the recorded run.
+ * @pre None.
+ * @post None.
+ * @return The number of the first generation that differed, or 0 if every
+ *         generation checked so far matched. Once the log is closed, a
+ *         recorded generation the run did not reach counts as differing.
+ */
+int ReplayLog::divergence(void) const
+{
+    return firstMismatch;
+} // end divergence()
+
+/** Finish the log. In checking mode, the recorded run must have ended where
+ *  the checked one did.
+ * @pre None.
+ * @post The file is closed. Nothing further is recorded or checked. If the
+ *       recorded run went on further, divergence() is the first generation
+ *       it recorded past the end of the checked one.
+ */
+void ReplayLog::close(void)
+{
+    Entry recorded;
+
+    if (file != NULL)
+    {
+        if (checking && firstMismatch == 0 &&
+            fread(&recorded, sizeof(recorded), 1, file) == 1)
+        {
+            firstMismatch = recorded.generation;
+        } // end if (checking && firstMismatch == 0 && ...)
+
+        fclose(file);
+        file = NULL;
+    } // end if (file != NULL)
+} // end close()
+
+/** Build the header that identifies a run.
+ * @param seed  The seed of the run.
+ * @param init  The puzzle being solved.
+ * @param popSize  The size of the first generation.
+ * @param settings  The tuning of the run.
+ * @param header  Storage for HEADER_SIZE bytes.
+ * @pre None.
+ * @post header holds the identity of the run.
+ */
+void ReplayLog::identify(uint64_t seed, const Puzzle& init, int popSize,
+                         const Tuning& settings, unsigned char *header)
+{
+    int32_t size = popSize, children = settings.children;
+    unsigned char *tuning = header + TUNING_AT;
+
+    memcpy(header, MAGIC, sizeof(MAGIC));
+    memcpy(header + SEED_AT, &seed, sizeof(seed));
+    init.pack(header + PUZZLE_AT);
+    memcpy(header + SIZE_AT, &size, sizeof(size));
+    memcpy(tuning, &children, sizeof(children));
+    memcpy(tuning + sizeof(children), &settings.mutantiness,
+           sizeof(settings.mutantiness));
+    memcpy(tuning + sizeof(children) + sizeof(settings.mutantiness),
+           &settings.survival, sizeof(settings.survival));
+} // end identify(uint64_t, Puzzle&, int, Tuning&, unsigned char*)
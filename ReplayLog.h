@@ -0,0 +1,131 @@
+/**
+ * @file    ReplayLog.h
+ * @brief   A compact record of the selection made in every generation of a
+ *          run, so that a run can be repeated, for example under a profiler,
+ *          and checked against the original generation by generation. Each
+ *          generation is stored as its number, its best fitness and a hash
+ *          of the Puzzles that survived selection. A log names the seed,
+ *          puzzle, population size and tuning of its run, and is checked
+ *          only against a run with all four the same.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#ifndef _REPLAYLOG_H
+#define	_REPLAYLOG_H
+
+#include <cstdio>
+#include <stdint.h>
+#include <string>
+
+#include "Population.h"
+
+using namespace std;
+
+struct Tuning;
+
+
+class ReplayLog
+{
+public:
+
+    /** Default constructor. The log is closed.
+     */
+    ReplayLog();
+
+    /** Destructor. Closes the log.
+     */
+    virtual ~ReplayLog();
+
+    /** Start a new log, replacing any file at path.
+     * @param path  The file to write.
+     * @param seed  The seed of the run being recorded.
+     * @param init  The puzzle being solved.
+     * @param popSize  The size of the first generation.
+     * @param settings  The tuning of the run.
+     * @pre None.
+     * @post Generations passed to note() are written to path.
+     * @return true if the file was opened, false otherwise.
+     */
+    bool record(const string& path, uint64_t seed, const Puzzle& init,
+                int popSize, const Tuning& settings);
+
+    /** Open an existing log to check a repeated run against it.
+     * @param path  A file written by record().
+     * @param seed  The seed of the run being checked.
+     * @param init  The puzzle being solved.
+     * @param popSize  The size of the first generation.
+     * @param settings  The tuning of the run.
+     * @pre None.
+     * @post Generations passed to note() are compared with path. If the file
+     *       was recorded for another run, mismatch() names what differs.
+     * @return true if the file was opened and was recorded with the same
+     *         seed, puzzle, population size and tuning, false otherwise.
+     */
+    bool verify(const string& path, uint64_t seed, const Puzzle& init,
+                int popSize, const Tuning& settings);
+
+    /** Provide what set the recorded run apart from the one verify() was
+     *  asked to check.
+     * @pre None.
+     * @post None.
+     * @return "seed", "puzzle", "population size" or "tuning", the first
+     *         that differed, or NULL if the last verify() found none or
+     *         could not read a log at all.
+     */
+    const char *mismatch(void) const;
+
+    /** Record or check the selection made in one generation.
+     * @param generation  The number of the generation, counting from 1.
+     * @param best  The best fitness after selection.
+     * @param survivors  The Population after selection.
+     * @pre The log is open.
+     * @post In recording mode, the generation is written. In checking mode, a
+     *       difference from the recorded run is remembered.
+     */
+    void note(int generation, int best, const Population& survivors);
+
+    /** Provide the first generation that differed from the recorded run.
+     * @pre None.
+     * @post None.
+     * @return The number of the first generation that differed, or 0 if every
+     *         generation checked so far matched. Once the log is closed, a
+     *         recorded generation the run did not reach counts as differing.
+     */
+    int divergence(void) const;
+
+    /** Finish the log. In checking mode, the recorded run must have ended
+     *  where the checked one did.
+     * @pre None.
+     * @post The file is closed. Nothing further is recorded or checked. If
+     *       the recorded run went on further, divergence() is the first
+     *       generation it recorded past the end of the checked one.
+     */
+    void close(void);
+
+private:
+
+    FILE *file;
+    bool checking;
+    int firstMismatch;
+    const char *conflict;       // what verify() found different, or NULL
+
+    /** Build the header that identifies a run.
+     * @param seed  The seed of the run.
+     * @param init  The puzzle being solved.
+     * @param popSize  The size of the first generation.
+     * @param settings  The tuning of the run.
+     * @param header  Storage for HEADER_SIZE bytes.
+     * @pre None.
+     * @post header holds the identity of the run.
+     */
+    static void identify(uint64_t seed, const Puzzle& init, int popSize,
+                         const Tuning& settings, unsigned char *header);
+
+    // Not copyable; the log owns an open file.
+    ReplayLog(const ReplayLog& orig);
+    void operator=(const ReplayLog& rhs);
+
+};
+
+#endif	/* _REPLAYLOG_H */
@@ -0,0 +1,231 @@
+/**
+ * @file    ResultWriter.cpp
+ * @brief   Writes many grids or solve results to a file in one of several
+ *          formats: a line of 81 digits, the grid as display() draws it
+ *          followed by a blank line, or a JSON object with the fitness,
+ *          generations, evaluations and status of a solve. Each item is
+ *          rendered straight into one large buffer that is reused from batch
+ *          to batch, and a batch goes out in a single write when it is
+ *          flushed or the buffer fills, rather than through a stream call
+ *          per character and a flush per row.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#include <cstring>
+
+#include "ResultWriter.h"
+
+static const int CELLS = ROWS * COLUMNS;
+static const size_t MOST_ITEM = 256;    // bytes any one item can take
+static const char *STATUS[] = { "solved", "exhausted", "timeout", "budget",
+                                "rejected", "cancelled" };
+static const char *FORMATS[] = { "line", "grid", "json" };
+
+
+/** Append text to an item being rendered.
+ * @param next  Where the text goes; moved past it.
+ * @param text  The text, null-terminated.
+ * @pre There is room for text.
+ * @post None.
+ */
+static void put(char *&next, const char *text)
+{
+    size_t length = strlen(text);
+
+    memcpy(next, text, length);
+    next += length;
+} // end put(char*&, char*)
+
+/** Append a number in decimal to an item being rendered.
+ * @param next  Where the digits go; moved past them.
+ * @param value  The number.
+ * @pre There is room for 20 chars.
+ * @post None.
+ */
+static void put(char *&next, long value)
+{
+    char digits[20];
+    int count = 0;
+    unsigned long rest = value < 0 ? 0UL - static_cast<unsigned long>(value) :
+                                     static_cast<unsigned long>(value);
+
+    do
+    {
+        digits[count++] = '0' + rest % 10;
+        rest /= 10;
+    } while (rest > 0);
+
+    if (value < 0)
+    {
+        *next++ = '-';
+    } // end if (value < 0)
+
+    while (count > 0)
+    {
+        *next++ = digits[--count];
+    } // end while (count > 0)
+} // end put(char*&, long)
+
+
+/** Constructor.
+ * @param out  The file to write to, which is not owned.
+ * @param format  How each item is written.
+ * @param capacity  Bytes to gather before writing, at least one item's worth.
+ */
+ResultWriter::ResultWriter(FILE *out, ResultFormat format, size_t capacity) :
+    out(out), format(format), buffer(max(capacity, MOST_ITEM)), used(0),
+    good(true)
+{
+} // end constructor
+
+/** Destructor. Writes anything still gathered.
+ */
+ResultWriter::~ResultWriter()
+{
+    flush();
+} // end destructor
+
+/** Add a grid. In JSON, only the grid is written.
+ * @param grid  The grid.
+ * @pre None.
+ * @post The grid is gathered; a full buffer has been written first.
+ */
+void ResultWriter::add(const Puzzle& grid)
+{
+    render(grid, NULL);
+} // end add(Puzzle&)
+
+/** Add the outcome of a solve. In JSON, the fitness, generations, evaluations
+ *  and status are written with the best grid; the other formats write the
+ *  best grid alone.
+ * @param result  The outcome.
+ * @pre None.
+ * @post The outcome is gathered; a full buffer has been written first.
+ */
+void ResultWriter::add(const SolveResult& result)
+{
+    render(result.best, &result);
+} // end add(SolveResult&)
+
+/** Write everything gathered, in a single write, and flush the file.
+ * @pre None.
+ * @post The buffer is empty and ready for the next batch.
+ * @return true if every write so far succeeded, false otherwise.
+ */
+bool ResultWriter::flush(void)
+{
+    if (used > 0)
+    {
+        good = fwrite(&buffer[0], used, 1, out) == 1 && good;
+        used = 0;
+    } // end if (used > 0)
+
+    good = fflush(out) == 0 && good;
+
+    return good;
+} // end flush()
+
+/** Provide the number of bytes gathered and not yet written.
+ * @pre None.
+ * @post None.
+ * @return The bytes pending.
+ */
+size_t ResultWriter::pending(void) const
+{
+    return used;
+} // end pending()
+
+/** Find the format with a given name: line, grid or json.
+ * @param text  The name.
+ * @param format  Set to the format if text names one.
+ * @pre None.
+ * @post format is unchanged unless true is returned.
+ * @return true if text names a format, false otherwise.
+ */
+bool ResultWriter::formatNamed(const char *text, ResultFormat& format)
+{
+    for (int i = 0; i <= JSON_FORMAT && text != NULL; ++i)
+    {
+        if (strcmp(text, FORMATS[i]) == 0)
+        {
+            format = static_cast<ResultFormat>(i);
+            return true;
+        } // end if (strcmp(text, FORMATS[i]) == 0)
+    } // end for (int i = 0; i <= JSON_FORMAT && text != NULL; ++i)
+
+    return false;
+} // end formatNamed(char*, ResultFormat&)
+
+/** Render an item at the end of the buffer, writing the buffer out first if
+ *  the item might not fit.
+ * @param grid  The grid.
+ * @param result  The outcome of its solve, or NULL for a bare grid.
+ * @pre None.
+ * @post The item is gathered.
+ */
+void ResultWriter::render(const Puzzle& grid, const SolveResult *result)
+{
+    if (buffer.size() - used < MOST_ITEM)
+    {
+        flush();
+    } // end if (buffer.size() - used < MOST_ITEM)
+
+    char cells[CELLS];
+    char *next = &buffer[used];
+
+    if (format != LINE_FORMAT)
+    {
+        grid.write(cells);
+    } // end if (format != LINE_FORMAT)
+
+    if (format == GRID_FORMAT)
+    {
+        for (int row = 0; row < ROWS; ++row)
+        {
+            const char *digits = cells + row * COLUMNS;
+
+            for (int j = 0; j < COLUMNS; ++j)
+            {
+                next[2 * j] = ' ';
+                next[2 * j + 1] = digits[j];
+            } // end for (int j = 0; j < COLUMNS; ++j)
+
+            next[2 * COLUMNS] = '\n';
+            next += 2 * COLUMNS + 1;
+        } // end for (int row = 0; row < ROWS; ++row)
+
+    }
+    else if (format == JSON_FORMAT)
+    {
+        put(next, "{\"grid\":\"");
+        memcpy(next, cells, CELLS);
+        next += CELLS;
+        *next++ = '"';
+
+        if (result != NULL)
+        {
+            put(next, ",\"fitness\":");
+            // A solve succeeds only on an IDEAL grid, so none is rescored.
+            put(next, static_cast<long>(result->status == SOLVED ?
+                                        IDEAL : result->best.fitness()));
+            put(next, ",\"generations\":");
+            put(next, static_cast<long>(result->generations));
+            put(next, ",\"evaluations\":");
+            put(next, result->evaluations);
+            put(next, ",\"status\":\"");
+            put(next, STATUS[result->status]);
+            *next++ = '"';
+        } // end if (result != NULL)
+
+        *next++ = '}';
+    }
+    else
+    {
+        grid.write(next);
+        next += CELLS;
+    } // end if (format == GRID_FORMAT)
+
+    *next++ = '\n';
+    used = next - &buffer[0];
+} // end render(Puzzle&, SolveResult*)
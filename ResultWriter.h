@@ -0,0 +1,113 @@
+/**
+ * @file    ResultWriter.h
+ * @brief   Writes many grids or solve results to a file in one of several
+ *          formats: a line of 81 digits, the grid as display() draws it
+ *          followed by a blank line, or a JSON object with the fitness,
+ *          generations, evaluations and status of a solve. Each item is
+ *          rendered straight into one large buffer that is reused from batch
+ *          to batch, and a batch goes out in a single write when it is
+ *          flushed or the buffer fills, rather than through a stream call
+ *          per character and a flush per row.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#ifndef _RESULTWRITER_H
+#define	_RESULTWRITER_H
+
+#include <cstdio>
+#include <vector>
+
+#include "GeneticAlgorithm.h"
+
+using namespace std;
+
+/** The ways an item can be written.
+ */
+enum ResultFormat
+{
+    LINE_FORMAT,            // 81 digits and a newline
+    GRID_FORMAT,            // nine rows as display() draws them, then a gap
+    JSON_FORMAT             // one JSON object per line
+};
+
+
+class ResultWriter
+{
+public:
+
+    /** Constructor.
+     * @param out  The file to write to, which is not owned.
+     * @param format  How each item is written.
+     * @param capacity  Bytes to gather before writing, at least one item's
+     *                  worth.
+     */
+    ResultWriter(FILE *out, ResultFormat format, size_t capacity = 1 << 20);
+
+    /** Destructor. Writes anything still gathered.
+     */
+    virtual ~ResultWriter();
+
+    /** Add a grid. In JSON, only the grid is written.
+     * @param grid  The grid.
+     * @pre None.
+     * @post The grid is gathered; a full buffer has been written first.
+     */
+    void add(const Puzzle& grid);
+
+    /** Add the outcome of a solve. In JSON, the fitness, generations,
+     *  evaluations and status are written with the best grid; the other
+     *  formats write the best grid alone.
+     * @param result  The outcome.
+     * @pre None.
+     * @post The outcome is gathered; a full buffer has been written first.
+     */
+    void add(const SolveResult& result);
+
+    /** Write everything gathered, in a single write, and flush the file.
+     * @pre None.
+     * @post The buffer is empty and ready for the next batch.
+     * @return true if every write so far succeeded, false otherwise.
+     */
+    bool flush(void);
+
+    /** Provide the number of bytes gathered and not yet written.
+     * @pre None.
+     * @post None.
+     * @return The bytes pending.
+     */
+    size_t pending(void) const;
+
+    /** Find the format with a given name: line, grid or json.
+     * @param text  The name.
+     * @param format  Set to the format if text names one.
+     * @pre None.
+     * @post format is unchanged unless true is returned.
+     * @return true if text names a format, false otherwise.
+     */
+    static bool formatNamed(const char *text, ResultFormat& format);
+
+private:
+
+    FILE *out;
+    ResultFormat format;
+    vector<char> buffer;
+    size_t used;                // bytes of buffer holding output
+    bool good;                  // false once a write has failed
+
+    /** Render an item at the end of the buffer, writing the buffer out
+     *  first if the item might not fit.
+     * @param grid  The grid.
+     * @param result  The outcome of its solve, or NULL for a bare grid.
+     * @pre None.
+     * @post The item is gathered.
+     */
+    void render(const Puzzle& grid, const SolveResult *result);
+
+    // Not copyable; a writer holds output not yet written.
+    ResultWriter(const ResultWriter& orig);
+    void operator=(const ResultWriter& rhs);
+
+};
+
+#endif	/* _RESULTWRITER_H */
@@ -0,0 +1,310 @@
+/**
+ * @file    SolutionCache.cpp
+ * @brief   Remembers the solutions to recently solved puzzles, so that a
+ *          puzzle seen before is answered without being solved again. Each
+ *          puzzle is filed under its canonical form from Symmetry, so a
+ *          puzzle whose digits have been relabelled, or whose rows, columns,
+ *          bands and stacks have been shuffled or transposed, finds the
+ *          solution of its twin, carried back to its own orientation. The
+ *          least recently used entry makes way when the cache is full. A
+ *          cache may also keep its entries in a file, which is read and
+ *          rewritten with just the entries held when it is opened, and
+ *          added to with every new solution. The cache may be shared by
+ *          many threads.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#include <cstring>
+
+#include "SolutionCache.h"
+#include "Symmetry.h"
+
+static const int CELLS = ROWS * COLUMNS;
+
+
+/** Tell whether a line of a cache file holds an entry: a canonical form and
+ *  its solution, separated by a space, where the solution keeps every clue
+ *  of the canonical form.
+ * @param line  The line, with or without its newline.
+ * @pre None.
+ * @post None.
+ * @return true if line is an entry, false otherwise.
+ */
+static bool isEntry(const char *line)
+{
+    for (int i = 0; i < CELLS; ++i)
+    {
+        if (line[i] < '0' || line[i] > '9' ||
+            line[CELLS + 1 + i] < '1' || line[CELLS + 1 + i] > '9' ||
+            (line[i] != '0' && line[i] != line[CELLS + 1 + i]))
+        {
+            return false;
+        } // end if (line[i] < '0' || line[i] > '9' || ...)
+    } // end for (int i = 0; i < CELLS; ++i)
+
+    return line[CELLS] == ' ' &&
+           Puzzle::fitnessOf(line + CELLS + 1) == CELLS;
+} // end isEntry(char*)
+
+
+/** Constructor.
+ * @param capacity  The most solutions to keep, at least 1.
+ */
+SolutionCache::SolutionCache(size_t capacity) :
+    capacity(capacity > 0 ? capacity : 1), file(NULL), hitCount(0),
+    missCount(0)
+{
+} // end constructor
+
+/** Destructor. Closes the file, if one is open.
+ */
+SolutionCache::~SolutionCache()
+{
+    if (file != NULL)
+    {
+        fclose(file);
+    } // end if (file != NULL)
+} // end destructor
+
+/** Keep the cache in a file. Entries already in the file are loaded, as many
+ *  of the most recent as fit, and the file is rewritten to hold only the
+ *  entries then held, so that lines for entries since dropped or stored
+ *  again do not pile up from run to run. Every later insert() is added to
+ *  it, so the file grows by a line per new solution until it is next
+ *  opened.
+ * @param path  The file, which is created if it does not exist.
+ * @pre None.
+ * @post On success, the file is open; a file already open is closed.
+ * @return true if the file was opened, false otherwise.
+ */
+bool SolutionCache::open(const string& path)
+{
+    FILE *store = fopen(path.c_str(), "a+");
+    char line[2 * CELLS + 3];
+
+    if (store == NULL)
+    {
+        return false;
+    } // end if (store == NULL)
+
+    lock_guard<mutex> hold(lock);
+
+    // Later lines are more recent, so they end up first.
+    rewind(store);
+
+    while (fgets(line, sizeof(line), store) != NULL)
+    {
+        if (strlen(line) >= 2 * CELLS + 1 && isEntry(line))
+        {
+            remember(string(line, CELLS), string(line + CELLS + 1, CELLS));
+        } // end if (strlen(line) >= 2 * CELLS + 1 && isEntry(line))
+    } // end while (fgets(line, sizeof(line), store) != NULL)
+
+    fclose(store);
+
+    // The entries are written oldest first, to a new file that replaces the
+    // old one only once it is complete. If it cannot be, the old one stays.
+    string fresh = path + ".tmp";
+    FILE *compact = fopen(fresh.c_str(), "w");
+
+    if (compact != NULL)
+    {
+        for (Entries::reverse_iterator at = entries.rbegin();
+             at != entries.rend(); ++at)
+        {
+            fprintf(compact, "%s %s\n", at->first.c_str(),
+                    at->second.c_str());
+        } // end for (Entries::reverse_iterator at = entries.rbegin(); ...)
+
+        if (fclose(compact) != 0 || rename(fresh.c_str(), path.c_str()) != 0)
+        {
+            remove(fresh.c_str());
+        } // end if (fclose(compact) != 0 || rename(...) != 0)
+    } // end if (compact != NULL)
+
+    store = fopen(path.c_str(), "a");
+
+    if (store == NULL)
+    {
+        return false;
+    } // end if (store == NULL)
+
+    if (file != NULL)
+    {
+        fclose(file);
+    } // end if (file != NULL)
+
+    file = store;
+
+    return true;
+} // end open(string&)
+
+/** Look up the solution to a puzzle.
+ * @param clues  The puzzle.
+ * @param solution  Set on a hit to the solution, in the orientation of clues.
+ * @pre None.
+ * @post A hit makes the entry the most recently used.
+ * @return true on a hit, false on a miss.
+ */
+bool SolutionCache::lookup(const Puzzle& clues, Puzzle& solution)
+{
+    char cells[CELLS], canonical[CELLS], found[CELLS];
+    Symmetry change;
+
+    clues.write(cells);
+
+    if (!Symmetry::canonicalize(cells, canonical, change))
+    {
+        lock_guard<mutex> hold(lock);
+
+        ++missCount;
+
+        return false;
+    } // end if (!Symmetry::canonicalize(cells, canonical, change))
+
+    if (!find(canonical, found))
+    {
+        return false;
+    } // end if (!find(canonical, found))
+
+    change.undo(found, cells);
+
+    return solution.read(cells);
+} // end lookup(Puzzle&, Puzzle&)
+
+/** Remember the solution to a puzzle.
+ * @param clues  The puzzle.
+ * @param solution  Its solution.
+ * @pre solution holds every clue of clues and has IDEAL fitness.
+ * @post The entry is the most recently used.
+ */
+void SolutionCache::store(const Puzzle& clues, const Puzzle& solution)
+{
+    char cells[CELLS], canonical[CELLS], solved[CELLS];
+    Symmetry change;
+
+    clues.write(cells);
+
+    if (Symmetry::canonicalize(cells, canonical, change))
+    {
+        solution.write(cells);
+        change.apply(cells, solved);
+        insert(canonical, solved);
+    } // end if (Symmetry::canonicalize(cells, canonical, change))
+} // end store(Puzzle&, Puzzle&)
+
+/** Look up a solution by canonical form.
+ * @param canonical  ROWS * COLUMNS chars from Symmetry::canonicalize().
+ * @param solution  Storage for ROWS * COLUMNS chars; set on a hit to the
+ *                  solution of canonical.
+ * @pre None.
+ * @post A hit makes the entry the most recently used.
+ * @return true on a hit, false on a miss.
+ */
+bool SolutionCache::find(const char *canonical, char *solution)
+{
+    lock_guard<mutex> hold(lock);
+    unordered_map<string, Entries::iterator>::iterator at =
+        index.find(string(canonical, CELLS));
+
+    if (at == index.end())
+    {
+        ++missCount;
+
+        return false;
+    } // end if (at == index.end())
+
+    entries.splice(entries.begin(), entries, at->second);
+    memcpy(solution, at->second->second.data(), CELLS);
+    ++hitCount;
+
+    return true;
+} // end find(char*, char*)
+
+/** Remember a solution by canonical form.
+ * @param canonical  ROWS * COLUMNS chars from Symmetry::canonicalize().
+ * @param solution  ROWS * COLUMNS chars, the solution of canonical.
+ * @pre None.
+ * @post The entry is the most recently used; the least recently used entry
+ *       is dropped if the cache was full.
+ */
+void SolutionCache::insert(const char *canonical, const char *solution)
+{
+    lock_guard<mutex> hold(lock);
+    string key(canonical, CELLS), value(solution, CELLS);
+
+    if (remember(key, value) && file != NULL)
+    {
+        fprintf(file, "%s %s\n", key.c_str(), value.c_str());
+        fflush(file);
+    } // end if (remember(key, value) && file != NULL)
+} // end insert(char*, char*)
+
+/** Provide the number of lookups answered.
+ * @pre None.
+ * @post None.
+ * @return The hits since construction.
+ */
+long SolutionCache::hits(void) const
+{
+    lock_guard<mutex> hold(lock);
+
+    return hitCount;
+} // end hits()
+
+/** Provide the number of lookups not answered.
+ * @pre None.
+ * @post None.
+ * @return The misses since construction.
+ */
+long SolutionCache::misses(void) const
+{
+    lock_guard<mutex> hold(lock);
+
+    return missCount;
+} // end misses()
+
+/** Provide the number of solutions held.
+ * @pre None.
+ * @post None.
+ * @return The number of entries.
+ */
+size_t SolutionCache::size(void) const
+{
+    lock_guard<mutex> hold(lock);
+
+    return entries.size();
+} // end size()
+
+/** Add or refresh an entry, without writing it to the file.
+ * @param canonical  The canonical form.
+ * @param solution  Its solution.
+ * @pre lock is held.
+ * @post The entry is the most recently used.
+ * @return true if the entry is new, false if it was already held.
+ */
+bool SolutionCache::remember(const string& canonical, const string& solution)
+{
+    unordered_map<string, Entries::iterator>::iterator at =
+        index.find(canonical);
+
+    if (at != index.end())
+    {
+        at->second->second = solution;
+        entries.splice(entries.begin(), entries, at->second);
+
+        return false;
+    } // end if (at != index.end())
+
+    if (entries.size() >= capacity)
+    {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    } // end if (entries.size() >= capacity)
+
+    entries.push_front(make_pair(canonical, solution));
+    index[canonical] = entries.begin();
+
+    return true;
+} // end remember(string&, string&)
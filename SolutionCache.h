@@ -0,0 +1,143 @@
+/**
+ * @file    SolutionCache.h
+ * @brief   Remembers the solutions to recently solved puzzles, so that a
+ *          puzzle seen before is answered without being solved again. Each
+ *          puzzle is filed under its canonical form from Symmetry, so a
+ *          puzzle whose digits have been relabelled, or whose rows, columns,
+ *          bands and stacks have been shuffled or transposed, finds the
+ *          solution of its twin, carried back to its own orientation. The
+ *          least recently used entry makes way when the cache is full. A
+ *          cache may also keep its entries in a file, which is read and
+ *          rewritten with just the entries held when it is opened, and
+ *          added to with every new solution. The cache may be shared by
+ *          many threads.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#ifndef _SOLUTIONCACHE_H
+#define	_SOLUTIONCACHE_H
+
+#include <cstdio>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "Puzzle.h"
+
+using namespace std;
+
+
+class SolutionCache
+{
+public:
+
+    /** Constructor.
+     * @param capacity  The most solutions to keep, at least 1.
+     */
+    explicit SolutionCache(size_t capacity);
+
+    /** Destructor. Closes the file, if one is open.
+     */
+    virtual ~SolutionCache();
+
+    /** Keep the cache in a file. Entries already in the file are loaded, as
+     *  many of the most recent as fit, and the file is rewritten to hold
+     *  only the entries then held, so that lines for entries since dropped
+     *  or stored again do not pile up from run to run. Every later insert()
+     *  is added to it, so the file grows by a line per new solution until
+     *  it is next opened.
+     * @param path  The file, which is created if it does not exist.
+     * @pre None.
+     * @post On success, the file is open; a file already open is closed.
+     * @return true if the file was opened, false otherwise.
+     */
+    bool open(const string& path);
+
+    /** Look up the solution to a puzzle.
+     * @param clues  The puzzle.
+     * @param solution  Set on a hit to the solution, in the orientation of
+     *                  clues.
+     * @pre None.
+     * @post A hit makes the entry the most recently used.
+     * @return true on a hit, false on a miss.
+     */
+    bool lookup(const Puzzle& clues, Puzzle& solution);
+
+    /** Remember the solution to a puzzle.
+     * @param clues  The puzzle.
+     * @param solution  Its solution.
+     * @pre solution holds every clue of clues and has IDEAL fitness.
+     * @post The entry is the most recently used.
+     */
+    void store(const Puzzle& clues, const Puzzle& solution);
+
+    /** Look up a solution by canonical form.
+     * @param canonical  ROWS * COLUMNS chars from Symmetry::canonicalize().
+     * @param solution  Storage for ROWS * COLUMNS chars; set on a hit to the
+     *                  solution of canonical.
+     * @pre None.
+     * @post A hit makes the entry the most recently used.
+     * @return true on a hit, false on a miss.
+     */
+    bool find(const char *canonical, char *solution);
+
+    /** Remember a solution by canonical form.
+     * @param canonical  ROWS * COLUMNS chars from Symmetry::canonicalize().
+     * @param solution  ROWS * COLUMNS chars, the solution of canonical.
+     * @pre None.
+     * @post The entry is the most recently used; the least recently used
+     *       entry is dropped if the cache was full.
+     */
+    void insert(const char *canonical, const char *solution);
+
+    /** Provide the number of lookups answered.
+     * @pre None.
+     * @post None.
+     * @return The hits since construction.
+     */
+    long hits(void) const;
+
+    /** Provide the number of lookups not answered.
+     * @pre None.
+     * @post None.
+     * @return The misses since construction.
+     */
+    long misses(void) const;
+
+    /** Provide the number of solutions held.
+     * @pre None.
+     * @post None.
+     * @return The number of entries.
+     */
+    size_t size(void) const;
+
+private:
+
+    typedef list<pair<string, string> > Entries;    // most recent first
+
+    mutable mutex lock;         // guards everything below
+    size_t capacity;
+    Entries entries;
+    unordered_map<string, Entries::iterator> index; // by canonical form
+    FILE *file;                 // NULL unless open() succeeded
+    long hitCount;
+    long missCount;
+
+    /** Add or refresh an entry, without writing it to the file.
+     * @param canonical  The canonical form.
+     * @param solution  Its solution.
+     * @pre lock is held.
+     * @post The entry is the most recently used.
+     * @return true if the entry is new, false if it was already held.
+     */
+    bool remember(const string& canonical, const string& solution);
+
+    // Not copyable; a cache may own a file.
+    SolutionCache(const SolutionCache& orig);
+    void operator=(const SolutionCache& rhs);
+
+};
+
+#endif	/* _SOLUTIONCACHE_H */
@@ -0,0 +1,304 @@
+/**
+ * @file    SolutionCounter.cpp
+ * @brief   An exact backtracking search over Sudoku grids, used where the
+ *          genetic algorithm cannot help: counting how many solutions a
+ *          puzzle has, and filling an empty grid at random to make new
+ *          puzzles. Candidates for each row, column and nonet are kept as
+ *          bitmasks, and the search always branches on the cell with the
+ *          fewest candidates. Grids are plain arrays of ROWS * COLUMNS ASCII
+ *          digits, '0' marking an empty cell.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#include "SolutionCounter.h"
+
+static const uint16_t ALL = 0x3FE;      // bits 1 through 9
+
+
+/** Find the nonet holding a cell.
+ * @param cell  The index of the cell.
+ * @pre 0 <= cell < ROWS * COLUMNS.
+ * @post None.
+ * @return The nonet, 0 to 8, left to right and top to bottom.
+ */
+static inline int nonetOf(int cell)
+{
+    return (cell / COLUMNS) / 3 * 3 + (cell % COLUMNS) / 3;
+} // end nonetOf(int)
+
+/** Count the bits set in a candidate mask.
+ * @param mask  The mask.
+ * @pre None.
+ * @post None.
+ * @return The number of candidates.
+ */
+static inline int countOf(uint16_t mask)
+{
+    return __builtin_popcount(mask);
+} // end countOf(uint16_t)
+
+
+/** Default constructor.
+ */
+SolutionCounter::SolutionCounter() : found(NULL), shuffle(NULL), solutions(0),
+                                     wanted(0), visited(0)
+{
+} // end default constructor
+
+/** Count the solutions of a puzzle, stopping early at a limit.
+ * @param cells  The puzzle.
+ * @param limit  Stop counting once this many solutions are found; 2 is enough
+ *               to tell a unique puzzle from an ambiguous one.
+ * @pre None.
+ * @post nodes() reports the effort of this count.
+ * @return The number of solutions found, at most limit. 0 if the clues
+ *         already break a rule of Sudoku.
+ */
+int SolutionCounter::count(const char *cells, int limit)
+{
+    solutions = 0;
+    wanted = limit;
+    visited = 0;
+    found = NULL;
+    shuffle = NULL;
+
+    if (load(cells))
+    {
+        search();
+    } // end if (load(cells))
+
+    return solutions;
+} // end count(char*, int)
+
+/** Decide whether a puzzle is fit to solve: its clues must not conflict, and
+ *  it must have exactly one solution. Conflicts are found without searching,
+ *  and the search stops at a second solution.
+ * @param cells  The puzzle.
+ * @pre None.
+ * @post nodes() reports the effort of this check.
+ * @return The verdict on the puzzle.
+ */
+Validity SolutionCounter::check(const char *cells)
+{
+    solutions = 0;
+    wanted = 2;
+    visited = 0;
+    found = NULL;
+    shuffle = NULL;
+
+    if (!load(cells))
+    {
+        return CONFLICTING;
+    } // end if (!load(cells))
+
+    search();
+
+    if (solutions == 0)
+    {
+        return UNSOLVABLE;
+    } // end if (solutions == 0)
+
+    return solutions == 1 ? UNIQUE : AMBIGUOUS;
+} // end check(char*)
+
+/** Provide a one-word description of a verdict.
+ * @param verdict  The verdict.
+ * @pre None.
+ * @post None.
+ * @return "unique", "conflicting", "unsolvable" or "ambiguous".
+ */
+const char *SolutionCounter::describe(Validity verdict)
+{
+    static const char *words[] = { "unique", "conflicting", "unsolvable",
+                                   "ambiguous" };
+
+    return words[verdict];
+} // end describe(Validity)
+
+/** Find one solution of a puzzle.
+ * @param cells  The puzzle.
+ * @param solution  Storage for ROWS * COLUMNS chars; set to the solution if
+ *                  there is one.
+ * @pre None.
+ * @post nodes() reports the effort of this search.
+ * @return true if a solution was found, false otherwise.
+ */
+bool SolutionCounter::solve(const char *cells, char *solution)
+{
+    solutions = 0;
+    wanted = 1;
+    visited = 0;
+    found = solution;
+    shuffle = NULL;
+
+    if (load(cells))
+    {
+        search();
+    } // end if (load(cells))
+
+    found = NULL;
+
+    return solutions > 0;
+} // end solve(char*, char*)
+
+/** Fill an empty grid with a random complete solution.
+ * @param rng  The source of randomness.
+ * @param solution  Storage for ROWS * COLUMNS chars.
+ * @pre None.
+ * @post solution holds a valid, completely filled grid.
+ */
+void SolutionCounter::fill(Random& rng, char *solution)
+{
+    char empty[ROWS * COLUMNS];
+
+    for (int i = 0; i < ROWS * COLUMNS; ++i)
+    {
+        empty[i] = '0';
+    } // end for (int i = 0; i < ROWS * COLUMNS; ++i)
+
+    solutions = 0;
+    wanted = 1;
+    visited = 0;
+    found = solution;
+    shuffle = &rng;
+
+    load(empty);
+    search();
+
+    found = NULL;
+    shuffle = NULL;
+} // end fill(Random&, char*)
+
+/** Provide the number of search nodes visited by the last call, a measure of
+ *  how hard the puzzle was to solve by search.
+ * @pre None.
+ * @post None.
+ * @return The number of cells assigned during the last search.
+ */
+long SolutionCounter::nodes(void) const
+{
+    return visited;
+} // end nodes()
+
+/** Load a puzzle and its candidate masks.
+ * @param cells  The puzzle.
+ * @pre None.
+ * @post The masks describe the clues.
+ * @return true if no clue repeats a digit in a row, column or nonet, false
+ *         otherwise.
+ */
+bool SolutionCounter::load(const char *cells)
+{
+    for (int i = 0; i < ROWS; ++i)
+    {
+        rowUsed[i] = columnUsed[i] = nonetUsed[i] = 0;
+    } // end for (int i = 0; i < ROWS; ++i)
+
+    for (int i = 0; i < ROWS * COLUMNS; ++i)
+    {
+        grid[i] = cells[i];
+
+        if (cells[i] != '0')
+        {
+            uint16_t bit = 1 << (cells[i] - '0');
+            int row = i / COLUMNS, column = i % COLUMNS, nonet = nonetOf(i);
+
+            if ((rowUsed[row] | columnUsed[column] | nonetUsed[nonet]) & bit)
+            {
+                return false;
+            } // end if ((rowUsed[row] | columnUsed[column] | ...) & bit)
+
+            rowUsed[row] |= bit;
+            columnUsed[column] |= bit;
+            nonetUsed[nonet] |= bit;
+        } // end if (cells[i] != '0')
+    } // end for (int i = 0; i < ROWS * COLUMNS; ++i)
+
+    return true;
+} // end load(char*)
+
+/** Search for solutions from the current grid until enough are found.
+ * @pre load() succeeded.
+ * @post solutions counts those found, up to wanted. The grid is restored to
+ *       its state on entry.
+ */
+void SolutionCounter::search(void)
+{
+    int best = -1, fewest = 10;
+    uint16_t options = 0;
+
+    // Branch on the empty cell with the fewest candidates.
+    for (int i = 0; i < ROWS * COLUMNS && fewest > 1; ++i)
+    {
+        if (grid[i] == '0')
+        {
+            uint16_t mask = ALL & ~(rowUsed[i / COLUMNS] |
+                                    columnUsed[i % COLUMNS] |
+                                    nonetUsed[nonetOf(i)]);
+            int size = countOf(mask);
+
+            if (size < fewest)
+            {
+                best = i;
+                fewest = size;
+                options = mask;
+            } // end if (size < fewest)
+        } // end if (grid[i] == '0')
+    } // end for (int i = 0; i < ROWS * COLUMNS && fewest > 1; ++i)
+
+    if (best < 0)                   // every cell is filled
+    {
+        if (found != NULL && solutions == 0)
+        {
+            for (int i = 0; i < ROWS * COLUMNS; ++i)
+            {
+                found[i] = grid[i];
+            } // end for (int i = 0; i < ROWS * COLUMNS; ++i)
+        } // end if (found != NULL && solutions == 0)
+
+        ++solutions;
+        return;
+    } // end if (best < 0)
+
+    int row = best / COLUMNS, column = best % COLUMNS, nonet = nonetOf(best);
+    int digits[9], total = 0;
+
+    for (int digit = 1; digit <= 9; ++digit)
+    {
+        if (options & (1 << digit))
+        {
+            digits[total++] = digit;
+        } // end if (options & (1 << digit))
+    } // end for (int digit = 1; digit <= 9; ++digit)
+
+    if (shuffle != NULL)            // Fisher-Yates, for random fills
+    {
+        for (int i = total - 1; i > 0; --i)
+        {
+            int j = shuffle->below(i + 1), temp = digits[i];
+
+            digits[i] = digits[j];
+            digits[j] = temp;
+        } // end for (int i = total - 1; i > 0; --i)
+    } // end if (shuffle != NULL)
+
+    for (int i = 0; i < total && solutions < wanted; ++i)
+    {
+        uint16_t bit = 1 << digits[i];
+
+        ++visited;
+        grid[best] = '0' + digits[i];
+        rowUsed[row] |= bit;
+        columnUsed[column] |= bit;
+        nonetUsed[nonet] |= bit;
+
+        search();
+
+        rowUsed[row] &= ~bit;
+        columnUsed[column] &= ~bit;
+        nonetUsed[nonet] &= ~bit;
+    } // end for (int i = 0; i < total && solutions < wanted; ++i)
+
+    grid[best] = '0';
+} // end search()
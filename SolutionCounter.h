@@ -0,0 +1,127 @@
+/**
+ * @file    SolutionCounter.h
+ * @brief   An exact backtracking search over Sudoku grids, used where the
+ *          genetic algorithm cannot help: counting how many solutions a
+ *          puzzle has, and filling an empty grid at random to make new
+ *          puzzles. Candidates for each row, column and nonet are kept as
+ *          bitmasks, and the search always branches on the cell with the
+ *          fewest candidates. Grids are plain arrays of ROWS * COLUMNS ASCII
+ *          digits, '0' marking an empty cell.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#ifndef _SOLUTIONCOUNTER_H
+#define	_SOLUTIONCOUNTER_H
+
+#include <stdint.h>
+
+#include "Puzzle.h"
+#include "Random.h"
+
+
+/** The verdict on a puzzle before it is solved.
+ */
+enum Validity
+{
+    UNIQUE,                 // exactly one solution; fit to solve
+    CONFLICTING,            // clues repeat a digit in a row, column or nonet
+    UNSOLVABLE,             // the clues agree, but no grid completes them
+    AMBIGUOUS               // more than one solution
+};
+
+
+class SolutionCounter
+{
+public:
+
+    /** Default constructor.
+     */
+    SolutionCounter();
+
+    /** Count the solutions of a puzzle, stopping early at a limit.
+     * @param cells  The puzzle.
+     * @param limit  Stop counting once this many solutions are found; 2 is
+     *               enough to tell a unique puzzle from an ambiguous one.
+     * @pre None.
+     * @post nodes() reports the effort of this count.
+     * @return The number of solutions found, at most limit. 0 if the clues
+     *         already break a rule of Sudoku.
+     */
+    int count(const char *cells, int limit);
+
+    /** Decide whether a puzzle is fit to solve: its clues must not conflict,
+     *  and it must have exactly one solution. Conflicts are found without
+     *  searching, and the search stops at a second solution.
+     * @param cells  The puzzle.
+     * @pre None.
+     * @post nodes() reports the effort of this check.
+     * @return The verdict on the puzzle.
+     */
+    Validity check(const char *cells);
+
+    /** Provide a one-word description of a verdict.
+     * @param verdict  The verdict.
+     * @pre None.
+     * @post None.
+     * @return "unique", "conflicting", "unsolvable" or "ambiguous".
+     */
+    static const char *describe(Validity verdict);
+
+    /** Find one solution of a puzzle.
+     * @param cells  The puzzle.
+     * @param solution  Storage for ROWS * COLUMNS chars; set to the solution
+     *                  if there is one.
+     * @pre None.
+     * @post nodes() reports the effort of this search.
+     * @return true if a solution was found, false otherwise.
+     */
+    bool solve(const char *cells, char *solution);
+
+    /** Fill an empty grid with a random complete solution.
+     * @param rng  The source of randomness.
+     * @param solution  Storage for ROWS * COLUMNS chars.
+     * @pre None.
+     * @post solution holds a valid, completely filled grid.
+     */
+    void fill(Random& rng, char *solution);
+
+    /** Provide the number of search nodes visited by the last call, a
+     *  measure of how hard the puzzle was to solve by search.
+     * @pre None.
+     * @post None.
+     * @return The number of cells assigned during the last search.
+     */
+    long nodes(void) const;
+
+private:
+
+    uint16_t rowUsed[ROWS];
+    uint16_t columnUsed[COLUMNS];
+    uint16_t nonetUsed[ROWS];
+    char grid[ROWS * COLUMNS];
+    char *found;            // where to copy the first solution, if anywhere
+    Random *shuffle;        // when set, candidates are tried in random order
+    int solutions;
+    int wanted;
+    long visited;
+
+    /** Load a puzzle and its candidate masks.
+     * @param cells  The puzzle.
+     * @pre None.
+     * @post The masks describe the clues.
+     * @return true if no clue repeats a digit in a row, column or nonet,
+     *         false otherwise.
+     */
+    bool load(const char *cells);
+
+    /** Search for solutions from the current grid until enough are found.
+     * @pre load() succeeded.
+     * @post solutions counts those found, up to wanted. The grid is
+     *       restored to its state on entry.
+     */
+    void search(void);
+
+};
+
+#endif	/* _SOLUTIONCOUNTER_H */
@@ -0,0 +1,468 @@
+/**
+ * @file    SolverDaemon.cpp
+ * @brief   A long-running solver that takes puzzles over a Unix domain socket,
+ *          so that callers do not pay for starting a process per puzzle.
+ *          Requests are queued and taken by a pool of workers in small
+ *          batches; each worker keeps one population buffer for its whole
+ *          life. Results are returned as they finish, in any order, tagged
+ *          with the request id and the time spent queued and solving. When
+ *          the queue is full, new requests are refused at once.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "SolverDaemon.h"
+
+static const char *STATUS[] = { "solved", "exhausted", "timeout", "budget" };
+static const int POLL_MSEC = 100;   // how often run() notices stop()
+
+
+/** Default constructor. Four workers, batches of eight, room for 1024 queued
+ *  requests, 750 Puzzles for up to 30000 generations, one second per request,
+ *  with validation.
+ */
+DaemonSettings::DaemonSettings() : socketPath("/tmp/sudoku.sock"), workers(4),
+                                   batchSize(8), queueLimit(1024),
+                                   popSize(750), maxGens(30000), seconds(1.0),
+                                   seed(1), validate(true)
+{
+} // end default constructor
+
+/** Constructor.
+ * @param socket  A connected socket, now owned by this Client.
+ */
+SolverDaemon::Client::Client(int socket) : fd(socket), sending(), outbox(),
+                                           inbox(), discarding(false)
+{
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+} // end constructor
+
+/** Destructor. Closes the socket.
+ */
+SolverDaemon::Client::~Client()
+{
+    close(fd);
+} // end destructor
+
+/** Constructor.
+ * @param settings  How to listen and how to solve.
+ */
+SolverDaemon::SolverDaemon(const DaemonSettings& settings) :
+    config(settings), running(false), answered(0), rejected(0), queueLock(),
+    queueReady(), queue(), pool()
+{
+} // end constructor
+
+/** Destructor. Stops the daemon if it is still running.
+ */
+SolverDaemon::~SolverDaemon()
+{
+    stop();
+} // end destructor
+
+/** Listen for requests and solve them until stop() is called.
+ * @pre No other process is listening at the socket path.
+ * @post The socket has been removed and every worker has finished.
+ * @return true if the daemon ran, false if the socket could not be opened.
+ */
+bool SolverDaemon::run(void)
+{
+    sockaddr_un address;
+    vector<shared_ptr<Client> > clients;
+    vector<pollfd> watched;
+    char buffer[65536];
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if (listener < 0 ||
+        config.socketPath.size() >= sizeof(address.sun_path))
+    {
+        if (listener >= 0)
+        {
+            close(listener);
+        } // end if (listener >= 0)
+
+        return false;
+    } // end if (listener < 0)
+
+    strcpy(address.sun_path, config.socketPath.c_str());
+    unlink(address.sun_path);       // left behind by an earlier run
+
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address),
+             sizeof(address)) != 0 || listen(listener, SOMAXCONN) != 0)
+    {
+        close(listener);
+        return false;
+    } // end if (bind(...) != 0 || listen(listener, SOMAXCONN) != 0)
+
+    running = true;
+
+    for (int i = 0; i < config.workers; ++i)
+    {
+        pool.push_back(thread(&SolverDaemon::work, this, i));
+    } // end for (int i = 0; i < config.workers; ++i)
+
+    while (running)
+    {
+        pollfd entry = { listener, POLLIN, 0 };
+
+        watched.assign(1, entry);
+
+        // A client is read only while it keeps up with its replies, and is
+        // written to only when it has replies held.
+        for (size_t i = 0; i < clients.size(); ++i)
+        {
+            lock_guard<mutex> guard(clients[i]->sending);
+            size_t held = clients[i]->outbox.size();
+
+            entry.fd = clients[i]->fd;
+            entry.events = (held < OUTBOX_LIMIT ? POLLIN : 0) |
+                           (held > 0 ? POLLOUT : 0);
+            watched.push_back(entry);
+        } // end for (size_t i = 0; i < clients.size(); ++i)
+
+        if (poll(&watched[0], watched.size(), POLL_MSEC) <= 0)
+        {
+            continue;               // timed out, or interrupted by a signal
+        } // end if (poll(&watched[0], watched.size(), POLL_MSEC) <= 0)
+
+        // Read from clients first, from the back, so that dropping one does
+        // not disturb the positions of those not yet visited.
+        for (size_t i = clients.size(); i > 0; --i)
+        {
+            if (watched[i].revents & POLLOUT)
+            {
+                lock_guard<mutex> guard(clients[i - 1]->sending);
+
+                flush(*clients[i - 1]);
+            } // end if (watched[i].revents & POLLOUT)
+
+            if ((watched[i].revents & ~POLLOUT) == 0)
+            {
+                continue;
+            } // end if ((watched[i].revents & ~POLLOUT) == 0)
+
+            ssize_t got = read(watched[i].fd, buffer, sizeof(buffer));
+
+            if (got > 0)
+            {
+                clients[i - 1]->inbox.append(buffer, got);
+                accept(clients[i - 1]);
+            }
+            else if (got == 0 || (errno != EAGAIN && errno != EINTR))
+            {
+                // Closed; queued jobs keep the Client alive.
+                clients.erase(clients.begin() + (i - 1));
+            } // end if (got > 0)
+        } // end for (size_t i = clients.size(); i > 0; --i)
+
+        if (watched[0].revents & POLLIN)
+        {
+            int fd = ::accept(listener, NULL, NULL);
+
+            if (fd >= 0)
+            {
+                clients.push_back(shared_ptr<Client>(new Client(fd)));
+            } // end if (fd >= 0)
+        } // end if (watched[0].revents & POLLIN)
+    } // end while (running)
+
+    queueReady.notify_all();
+
+    for (size_t i = 0; i < pool.size(); ++i)
+    {
+        pool[i].join();
+    } // end for (size_t i = 0; i < pool.size(); ++i)
+
+    pool.clear();
+
+    // Whatever was still waiting will not be solved now.
+    while (!queue.empty())
+    {
+        reply(*queue.front().client, queue.front().id + " busy\n");
+        queue.pop_front();
+        ++rejected;
+    } // end while (!queue.empty())
+
+    close(listener);
+    unlink(address.sun_path);
+
+    return true;
+} // end run()
+
+/** Ask run() to return. Safe to call from a signal handler.
+ * @pre None.
+ * @post run() returns after the requests in progress are finished.
+ */
+void SolverDaemon::stop(void)
+{
+    running = false;
+} // end stop()
+
+/** Provide the number of requests answered with a result.
+ * @pre None.
+ * @post None.
+ * @return The count of completed requests.
+ */
+long SolverDaemon::served(void) const
+{
+    return answered;
+} // end served()
+
+/** Provide the number of requests refused because the queue was full.
+ * @pre None.
+ * @post None.
+ * @return The count of refused requests.
+ */
+long SolverDaemon::refused(void) const
+{
+    return rejected;
+} // end refused()
+
+/** Take batches of jobs from the queue and solve them until stopped.
+ * @param index  Which worker this is, for choosing its random stream.
+ * @pre None.
+ * @post Every job taken has been answered.
+ */
+void SolverDaemon::work(int index)
+{
+    Random seeds(config.seed, index);   // one stream per worker
+    Population workspace;           // reused by every job this worker takes
+    vector<Job> batch;
+    char line[256];
+
+    workspace.reserve(config.popSize);
+    batch.reserve(config.batchSize);
+
+    while (true)
+    {
+        {
+            unique_lock<mutex> guard(queueLock);
+
+            while (queue.empty() && running)
+            {
+                // Waits are bounded since stop() may not be able to notify.
+                queueReady.wait_for(guard, chrono::milliseconds(POLL_MSEC));
+            } // end while (queue.empty() && running)
+
+            if (!running)
+            {
+                break;
+            } // end if (!running)
+
+            // Take a fair share of what is waiting, so that one worker does
+            // not hold a whole batch while others sit idle.
+            size_t share = (queue.size() + config.workers - 1) /
+                           config.workers;
+            size_t take = min(share, static_cast<size_t>(config.batchSize));
+
+            while (batch.size() < take)
+            {
+                batch.push_back(queue.front());
+                queue.pop_front();
+            } // end while (batch.size() < take)
+        }
+
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            Job& job = batch[i];
+            SolveLimits limits;
+            Clock::time_point start = Clock::now();
+            char cells[ROWS * COLUMNS];
+
+            if (config.seconds > 0.0)
+            {
+                limits.hasDeadline = true;
+                limits.deadline = job.arrival +
+                    chrono::duration_cast<Clock::duration>(
+                        chrono::duration<double>(config.seconds));
+            } // end if (config.seconds > 0.0)
+
+            limits.validate = config.validate;
+
+            GeneticAlgorithm engine(job.puzzle, config.popSize,
+                                    config.maxGens);
+            engine.seed(seeds.next());
+            SolveResult result = engine.evolve(limits, workspace);
+            Clock::time_point end = Clock::now();
+
+            if (result.status == REJECTED)
+            {
+                reply(*job.client, job.id + " " +
+                      SolutionCounter::describe(result.validity) + "\n");
+                ++answered;
+                continue;
+            } // end if (result.status == REJECTED)
+
+            result.best.write(cells);
+            snprintf(line, sizeof(line), " %s %.81s %d %d %lld %lld\n",
+                     STATUS[result.status], cells, result.best.fitness(),
+                     result.generations,
+                     static_cast<long long>(chrono::duration_cast<
+                         chrono::microseconds>(start - job.arrival).count()),
+                     static_cast<long long>(chrono::duration_cast<
+                         chrono::microseconds>(end - start).count()));
+            reply(*job.client, job.id + line);
+            ++answered;
+        } // end for (size_t i = 0; i < batch.size(); ++i)
+
+        batch.clear();
+    } // end while (true)
+} // end work(int)
+
+/** Split the complete lines a client has sent into jobs.
+ * @param client  The client whose inbox is to be read.
+ * @pre None.
+ * @post Complete lines have been removed from the inbox and either queued or
+ *       refused.
+ */
+void SolverDaemon::accept(const shared_ptr<Client>& client)
+{
+    string& inbox = client->inbox;
+    size_t begin = 0, end;
+    Clock::time_point now = Clock::now();
+
+    while ((end = inbox.find('\n', begin)) != string::npos)
+    {
+        string text = inbox.substr(begin, min(end - begin, LINE_LIMIT + 1));
+        bool overlong = text.size() > LINE_LIMIT;
+        Job job;
+
+        begin = end + 1;
+
+        if (client->discarding)     // the end of a line already answered
+        {
+            client->discarding = false;
+            continue;
+        } // end if (client->discarding)
+
+        if (overlong)
+        {
+            text.erase(LINE_LIMIT);
+        } // end if (overlong)
+
+        if (!text.empty() && text[text.size() - 1] == '\r')
+        {
+            text.erase(text.size() - 1);
+        } // end if (!text.empty() && text[text.size() - 1] == '\r')
+
+        if (text.empty())
+        {
+            continue;
+        } // end if (text.empty())
+
+        size_t space = text.find(' ');
+
+        job.id = text.substr(0, space);
+
+        if (overlong || space == string::npos || space == 0 ||
+            text.size() - space - 1 != static_cast<size_t>(ROWS * COLUMNS) ||
+            !job.puzzle.read(text.c_str() + space + 1))
+        {
+            reply(*client, job.id + " invalid\n");
+            continue;
+        } // end if (space == string::npos || space == 0 || ...)
+
+        job.client = client;
+        job.arrival = now;
+
+        {
+            lock_guard<mutex> guard(queueLock);
+
+            if (queue.size() < config.queueLimit)
+            {
+                queue.push_back(job);
+                job.client.reset();
+            } // end if (queue.size() < config.queueLimit)
+        }
+
+        if (job.client)             // still ours, so it was not queued
+        {
+            reply(*client, job.id + " busy\n");
+            ++rejected;
+        }
+        else
+        {
+            queueReady.notify_one();
+        } // end if (job.client)
+    } // end while ((end = inbox.find('\n', begin)) != string::npos)
+
+    inbox.erase(0, begin);
+
+    // A line that has grown too long without ending is answered now, and
+    // the rest of it is dropped as it arrives.
+    if (client->discarding)
+    {
+        inbox.clear();
+    }
+    else if (inbox.size() > LINE_LIMIT)
+    {
+        string text = inbox.substr(0, LINE_LIMIT);
+
+        reply(*client, text.substr(0, text.find(' ')) + " invalid\n");
+        inbox.clear();
+        client->discarding = true;
+    } // end if (client->discarding)
+} // end accept(shared_ptr<Client>&)
+
+/** Send one line to a client, ignoring a client that has gone away. Whatever
+ *  the socket will not take at once is held in the outbox.
+ * @param client  The recipient.
+ * @param line  The text to send, ending in a newline.
+ * @pre None.
+ * @post None.
+ */
+void SolverDaemon::reply(Client& client, const string& line)
+{
+    lock_guard<mutex> guard(client.sending);
+
+    client.outbox += line;
+    flush(client);
+} // end reply(Client&, string&)
+
+/** Send as much of a client's outbox as its socket will take without
+ *  waiting. The outbox is emptied if the client has gone away.
+ * @param client  The recipient.
+ * @pre client.sending is held by the caller.
+ * @post What was sent has been removed from the outbox.
+ */
+void SolverDaemon::flush(Client& client)
+{
+    size_t sent = 0;
+
+    while (sent < client.outbox.size())
+    {
+        ssize_t count = send(client.fd, client.outbox.data() + sent,
+                             client.outbox.size() - sent, MSG_NOSIGNAL);
+
+        if (count > 0)
+        {
+            sent += count;
+        }
+        else if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        else if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            break;                  // full; the rest waits for POLLOUT
+        }
+        else                        // gone away; nothing more will be read
+        {
+            sent = client.outbox.size();
+        } // end if (count > 0)
+    } // end while (sent < client.outbox.size())
+
+    client.outbox.erase(0, sent);
+} // end flush(Client&)
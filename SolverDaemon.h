@@ -0,0 +1,188 @@
+/**
+ * @file    SolverDaemon.h
+ * @brief   A long-running solver that takes puzzles over a Unix domain socket,
+ *          so that callers do not pay for starting a process per puzzle.
+ *          Requests are queued and taken by a pool of workers in small
+ *          batches; each worker keeps one population buffer for its whole
+ *          life. Results are returned as they finish, in any order, tagged
+ *          with the request id and the time spent queued and solving. When
+ *          the queue is full, new requests are refused at once.
+ *
+ *          Protocol, one request or response per line:
+ *            request:  <id> <81 digits>
+ *            response: <id> <status> <81 digits> <fitness> <generations>
+ *                      <queued usec> <solve usec>
+ *            refusal:  <id> busy
+ *            bad line: <id> invalid
+ *            rejected: <id> conflicting|unsolvable|ambiguous
+ *          where <status> is one of solved, exhausted, timeout or budget.
+ *          Puzzles are rejected before solving if validation is on. A line
+ *          longer than LINE_LIMIT is answered as invalid and dropped. A
+ *          client is never waited on: replies it has not read are held for
+ *          it, and its further requests are not read while OUTBOX_LIMIT
+ *          bytes of them are held.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#ifndef _SOLVERDAEMON_H
+#define	_SOLVERDAEMON_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "GeneticAlgorithm.h"
+
+using namespace std;
+
+const size_t LINE_LIMIT = 1024;     // longest request line, in bytes
+const size_t OUTBOX_LIMIT = 65536;  // held replies before reading stops
+
+
+/** Settings for a SolverDaemon.
+ */
+struct DaemonSettings
+{
+    /** Default constructor. Four workers, batches of eight, room for 1024
+     *  queued requests, 750 Puzzles for up to 30000 generations, one second
+     *  per request, with validation.
+     */
+    DaemonSettings();
+
+    string socketPath;
+    int workers;
+    int batchSize;              // most requests a worker takes at once
+    size_t queueLimit;          // queued requests before refusing more
+    int popSize;
+    int maxGens;
+    double seconds;             // from arrival; 0 or less for no limit
+    uint64_t seed;
+    bool validate;              // reject puzzles without one solution
+};
+
+
+class SolverDaemon
+{
+public:
+
+    /** Constructor.
+     * @param settings  How to listen and how to solve.
+     */
+    explicit SolverDaemon(const DaemonSettings& settings);
+
+    /** Destructor. Stops the daemon if it is still running.
+     */
+    virtual ~SolverDaemon();
+
+    /** Listen for requests and solve them until stop() is called.
+     * @pre No other process is listening at the socket path.
+     * @post The socket has been removed and every worker has finished.
+     * @return true if the daemon ran, false if the socket could not be
+     *         opened.
+     */
+    bool run(void);
+
+    /** Ask run() to return. Safe to call from a signal handler.
+     * @pre None.
+     * @post run() returns after the requests in progress are finished.
+     */
+    void stop(void);
+
+    /** Provide the number of requests answered with a result.
+     * @pre None.
+     * @post None.
+     * @return The count of completed requests.
+     */
+    long served(void) const;
+
+    /** Provide the number of requests refused because the queue was full.
+     * @pre None.
+     * @post None.
+     * @return The count of refused requests.
+     */
+    long refused(void) const;
+
+private:
+
+    typedef SolveLimits::Clock Clock;
+
+    /** A connected caller. Workers answer through it after the reader has
+     *  moved on, so it is shared, and it closes its socket when the last
+     *  reference is gone.
+     */
+    struct Client
+    {
+        explicit Client(int socket);
+        ~Client();
+
+        int fd;                 // non-blocking
+        mutex sending;          // guards outbox
+        string outbox;          // bytes replied but not yet sent
+        string inbox;           // bytes read but not yet a full line
+        bool discarding;        // inbox is the rest of an overlong line
+    };
+
+    /** One puzzle waiting to be solved.
+     */
+    struct Job
+    {
+        shared_ptr<Client> client;
+        string id;
+        Puzzle puzzle;
+        Clock::time_point arrival;
+    };
+
+    DaemonSettings config;
+    atomic<bool> running;
+    atomic<long> answered;
+    atomic<long> rejected;
+    mutex queueLock;
+    condition_variable queueReady;
+    deque<Job> queue;
+    vector<thread> pool;
+
+    /** Take batches of jobs from the queue and solve them until stopped.
+     * @param index  Which worker this is, for choosing its random stream.
+     * @pre None.
+     * @post Every job taken has been answered.
+     */
+    void work(int index);
+
+    /** Split the complete lines a client has sent into jobs.
+     * @param client  The client whose inbox is to be read.
+     * @pre None.
+     * @post Complete lines have been removed from the inbox and either
+     *       queued or refused.
+     */
+    void accept(const shared_ptr<Client>& client);
+
+    /** Send one line to a client, ignoring a client that has gone away.
+     *  Whatever the socket will not take at once is held in the outbox.
+     * @param client  The recipient.
+     * @param line  The text to send, ending in a newline.
+     * @pre None.
+     * @post None.
+     */
+    static void reply(Client& client, const string& line);
+
+    /** Send as much of a client's outbox as its socket will take without
+     *  waiting. The outbox is emptied if the client has gone away.
+     * @param client  The recipient.
+     * @pre client.sending is held by the caller.
+     * @post What was sent has been removed from the outbox.
+     */
+    static void flush(Client& client);
+
+    // Not copyable; the daemon owns threads and a socket.
+    SolverDaemon(const SolverDaemon& orig);
+    void operator=(const SolverDaemon& rhs);
+
+};
+
+#endif	/* _SOLVERDAEMON_H */
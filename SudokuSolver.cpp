@@ -0,0 +1,463 @@
+/**
+ * @file    SudokuSolver.cpp
+ * @brief   A C interface to the genetic algorithm solver, for embedding it in
+ *          other programs instead of running the sudoku executable. Each
+ *          solver handle is independent, so separate threads may use separate
+ *          handles at the same time. Puzzles are passed as 81 ASCII digits in
+ *          row order, '0' marking an empty cell, and results are written to
+ *          buffers owned by the caller. Nothing here reads or writes a stream.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#include <new>
+
+#include "BatchSolver.h"
+#include "GeneticAlgorithm.h"
+#include "SudokuSolver.h"
+
+
+/** The state behind a solver handle. Seeds for successive solves are drawn
+ *  from a generator of its own, so no state is shared between handles.
+ */
+struct sudoku_solver
+{
+    sudoku_params params;
+    Random seeds;
+    BatchSolver *batch;                 // NULL unless params.threads > 1
+    SolutionCache *cache;               // NULL unless params.cache_size > 0
+    Population last;                    // left by the latest sudoku_solve()
+};
+
+
+/** Passes each new best grid of a solve to a solver's progress callback.
+ */
+class CallbackListener : public ProgressListener
+{
+public:
+
+    /** Constructor.
+     * @param params  The settings holding the callback.
+     */
+    explicit CallbackListener(const sudoku_params& params) : params(params)
+    {
+    } // end constructor
+
+    /** Hear of a new best Puzzle, and pass it on.
+     * @param best  The most fit Puzzle so far.
+     * @param fitness  Its fitness.
+     * @param generation  The number of the generation that found it.
+     * @pre params.progress is not NULL.
+     * @post None.
+     * @return false if the callback returned 0, true otherwise.
+     */
+    virtual bool improved(const Puzzle& best, int fitness, int generation)
+    {
+        char cells[SUDOKU_CELLS];
+
+        best.write(cells);
+
+        return params.progress(params.progress_context, cells, fitness,
+                               generation) != 0;
+    } // end improved(Puzzle&, int, int)
+
+private:
+
+    const sudoku_params& params;
+
+};
+
+
+/** Solve several puzzles on a solver's workers.
+ * @param solver  A solver with a BatchSolver.
+ * @param puzzles  count * SUDOKU_CELLS ASCII digits, back to back.
+ * @param count  The number of puzzles.
+ * @param solutions  Storage for count * SUDOKU_CELLS chars.
+ * @param results  Storage for count results; may be NULL.
+ * @pre solver->batch is not NULL.
+ * @post Puzzles that could not be read are reported as SUDOKU_INVALID.
+ * @return The number of puzzles that were solved.
+ */
+static size_t solveShared(sudoku_solver *solver, const char *puzzles,
+                          size_t count, char *solutions,
+                          sudoku_result *results)
+{
+    vector<Puzzle> batch(count);
+    vector<bool> readable(count);
+    vector<SolveResult> found;
+    SolveLimits limits;
+    size_t solved;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        readable[i] = batch[i].read(puzzles + i * SUDOKU_CELLS);
+    } // end for (size_t i = 0; i < count; ++i)
+
+    limits.maxEvaluations = solver->params.max_evaluations;
+    limits.maxMemory = solver->params.max_memory;
+    limits.validate = solver->params.validate != 0;
+
+    solved = solver->batch->solve(batch, limits, solver->params.seconds,
+                                  solver->seeds.next(), found);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        sudoku_result outcome = { SUDOKU_INVALID, 0, 0, 0, SUDOKU_UNIQUE };
+
+        if (readable[i])
+        {
+            found[i].best.write(solutions + i * SUDOKU_CELLS);
+            outcome.status = found[i].status;
+            outcome.fitness = found[i].best.fitness();
+            outcome.generations = found[i].generations;
+            outcome.evaluations = found[i].evaluations;
+            outcome.validity = found[i].validity;
+        } // end if (readable[i])
+
+        if (results != NULL)
+        {
+            results[i] = outcome;
+        } // end if (results != NULL)
+    } // end for (size_t i = 0; i < count; ++i)
+
+    return solved;
+} // end solveShared(sudoku_solver*, char*, size_t, char*, sudoku_result*)
+
+
+/** Gather the settings of the search from a solver's settings.
+ * @param params  The solver's settings.
+ * @pre None.
+ * @post None.
+ * @return The mutation rate, survival and children of params.
+ */
+static Tuning tuningOf(const sudoku_params& params)
+{
+    Tuning chosen;
+
+    chosen.mutantiness = params.mutation;
+    chosen.survival = params.survival;
+    chosen.children = params.children;
+
+    return chosen;
+} // end tuningOf(sudoku_params&)
+
+/** Check that a puzzle has exactly one solution, as validation does.
+ * @param clues  The puzzle.
+ * @pre None.
+ * @post None.
+ * @return true if it has one solution, false otherwise.
+ */
+static bool unique(const Puzzle& clues)
+{
+    char cells[ROWS * COLUMNS];
+    SolutionCounter checker;
+
+    clues.write(cells);
+
+    return checker.check(cells) == UNIQUE;
+} // end unique(Puzzle&)
+
+/** Solve one puzzle, from scratch or from the solver's latest population.
+ * @param solver  A solver from sudoku_solver_create(), or NULL.
+ * @param puzzle  SUDOKU_CELLS ASCII digits.
+ * @param solution  Storage for SUDOKU_CELLS chars, not null-terminated. The
+ *                  best grid found is written here.
+ * @param result  Where to describe the outcome; may be NULL.
+ * @param warm  Whether to start from the population of the latest solve.
+ * @pre None.
+ * @post solver->last holds the final population of a run, if one was made.
+ * @return The status of the solve, as in enum sudoku_status.
+ */
+static int solveOne(sudoku_solver *solver, const char *puzzle,
+                    char *solution, sudoku_result *result, bool warm)
+{
+    Puzzle init;
+    SolveLimits limits;
+    SolveResult found;
+    sudoku_result outcome = { SUDOKU_INVALID, 0, 0, 0, SUDOKU_UNIQUE };
+
+    if (solver != NULL && puzzle != NULL && solution != NULL &&
+        init.read(puzzle))
+    {
+        if (solver->params.seconds > 0.0)
+        {
+            limits = SolveLimits::within(solver->params.seconds);
+        } // end if (solver->params.seconds > 0.0)
+
+        limits.maxEvaluations = solver->params.max_evaluations;
+        limits.maxMemory = solver->params.max_memory;
+        limits.validate = solver->params.validate != 0;
+
+        uint64_t seed = solver->seeds.next();   // drawn even on a hit
+
+        // A hit is checked as a run would be, since the cache does not know
+        // whether its solution was the only one.
+        if (solver->cache != NULL &&
+            solver->cache->lookup(init, found.best) &&
+            (!limits.validate || unique(init)))
+        {
+            found.status = SOLVED;
+            found.generations = 0;
+            found.evaluations = 0;
+            found.validity = UNIQUE;
+        }
+        else
+        {
+            GeneticAlgorithm engine(init, solver->params.pop_size,
+                                    solver->params.max_gens);
+            CallbackListener listener(solver->params);
+
+            engine.seed(seed);
+            engine.tune(tuningOf(solver->params));
+
+            if (solver->params.progress != NULL)
+            {
+                engine.reportTo(&listener);
+            } // end if (solver->params.progress != NULL)
+
+            if (warm)
+            {
+                engine.warmStart(solver->last);     // false if there is none
+            } // end if (warm)
+
+            found = engine.evolve(limits, solver->last);
+
+            if (solver->cache != NULL && found.status == SOLVED)
+            {
+                solver->cache->store(init, found.best);
+            } // end if (solver->cache != NULL && found.status == SOLVED)
+        } // end if (solver->cache != NULL && ...)
+
+        found.best.write(solution);
+
+        outcome.status = found.status;
+        outcome.fitness = found.best.fitness();
+        outcome.generations = found.generations;
+        outcome.evaluations = found.evaluations;
+        outcome.validity = found.validity;
+    } // end if (solver != NULL && puzzle != NULL && solution != NULL)
+
+    if (result != NULL)
+    {
+        *result = outcome;
+    } // end if (result != NULL)
+
+    return outcome.status;
+} // end solveOne(sudoku_solver*, char*, char*, sudoku_result*, bool)
+
+/** Fill in the default settings: 750 Puzzles, 30000 generations, no limits,
+ *  validation on, one thread, no cache, no progress callback, and a mutation
+ *  rate of 0.05 with a tenth of each generation kept to breed 9 children
+ *  each.
+ * @param params  The settings to fill in.
+ */
+void sudoku_params_init(sudoku_params *params)
+{
+    params->pop_size = 750;
+    params->max_gens = 30000;
+    params->seconds = 0.0;
+    params->max_evaluations = 0;
+    params->max_memory = 0;
+    params->seed = 0;
+    params->validate = 1;
+    params->threads = 1;
+    params->cache_size = 0;
+    params->cache_path = NULL;
+    params->progress = NULL;
+    params->progress_context = NULL;
+    params->mutation = MUTANTINESS;
+    params->survival = SURVIVAL;
+    params->children = CHILDREN;
+} // end sudoku_params_init(sudoku_params*)
+
+/** Create a solver.
+ * @param params  Its settings, or NULL for the defaults.
+ * @return A new solver, or NULL if the settings are unusable, the cache file
+ *         cannot be opened or memory ran out. Release it with
+ *         sudoku_solver_destroy().
+ */
+sudoku_solver *sudoku_solver_create(const sudoku_params *params)
+{
+    sudoku_params chosen;
+    sudoku_solver *solver;
+
+    if (params != NULL)
+    {
+        chosen = *params;
+    }
+    else
+    {
+        sudoku_params_init(&chosen);
+    } // end if (params != NULL)
+
+    // Fewer than 10 Puzzles leaves no survivors to breed from.
+    if (chosen.pop_size < 10 || chosen.max_gens < 1 || chosen.threads < 1 ||
+        !tuningOf(chosen).usable(chosen.pop_size))
+    {
+        return NULL;
+    } // end if (chosen.pop_size < 10 || chosen.max_gens < 1 || ...)
+
+    if (chosen.seed == 0)
+    {
+        chosen.seed = static_cast<unsigned long long>(
+            SolveLimits::Clock::now().time_since_epoch().count());
+    } // end if (chosen.seed == 0)
+
+    solver = new (std::nothrow) sudoku_solver;
+
+    if (solver != NULL)
+    {
+        solver->params = chosen;
+        solver->seeds = Random(chosen.seed);
+        solver->batch = NULL;
+        solver->cache = NULL;
+
+        // Generations are handed out 50 at a time: long enough that taking
+        // a job costs nothing next to running it.
+        if (chosen.threads > 1)
+        {
+            solver->batch = new (std::nothrow) BatchSolver(
+                chosen.threads, chosen.pop_size, chosen.max_gens, 50);
+        } // end if (chosen.threads > 1)
+
+        if (chosen.cache_size > 0)
+        {
+            solver->cache = new (std::nothrow) SolutionCache(
+                chosen.cache_size);
+
+            if (solver->cache != NULL && chosen.cache_path != NULL &&
+                !solver->cache->open(chosen.cache_path))
+            {
+                delete solver->cache;
+                solver->cache = NULL;
+            } // end if (solver->cache != NULL && ...)
+        } // end if (chosen.cache_size > 0)
+
+        if (solver->batch != NULL)
+        {
+            solver->batch->tuneWith(tuningOf(chosen));
+        } // end if (solver->batch != NULL)
+
+        if ((chosen.threads > 1 && solver->batch == NULL) ||
+            (chosen.cache_size > 0 && solver->cache == NULL))
+        {
+            sudoku_solver_destroy(solver);
+            solver = NULL;
+        }
+        else if (solver->batch != NULL)
+        {
+            solver->batch->cacheWith(solver->cache);
+        } // end if ((chosen.threads > 1 && solver->batch == NULL) || ...)
+    } // end if (solver != NULL)
+
+    return solver;
+} // end sudoku_solver_create(sudoku_params*)
+
+/** Solve one puzzle. A solver with a cache answers a puzzle equivalent to one
+ *  it has solved before without solving it again, reporting it SOLVED in no
+ *  generations. With validation on, the puzzle is still checked first,
+ *  whatever run cached its solution.
+ * @param solver  A solver from sudoku_solver_create().
+ * @param puzzle  SUDOKU_CELLS ASCII digits.
+ * @param solution  Storage for SUDOKU_CELLS chars, not null-terminated. The
+ *                  best grid found is written here.
+ * @param result  Where to describe the outcome; may be NULL.
+ * @return The status of the solve, as in enum sudoku_status.
+ */
+int sudoku_solve(sudoku_solver *solver, const char *puzzle, char *solution,
+                 sudoku_result *result)
+{
+    return solveOne(solver, puzzle, solution, result, false);
+} // end sudoku_solve(sudoku_solver*, char*, char*, sudoku_result*)
+
+/** Solve a puzzle again after it has gained clues, such as after a move in an
+ *  interactive game. The run starts from the population left by the
+ *  solver's latest solve, repaired to fit the new clues, rather than from
+ *  random grids, so a puzzle that has moved on only a little is solved in a
+ *  fraction of the time. With no earlier solve, this is sudoku_solve().
+ * @param solver  A solver from sudoku_solver_create().
+ * @param puzzle  SUDOKU_CELLS ASCII digits.
+ * @param solution  Storage for SUDOKU_CELLS chars, not null-terminated. The
+ *                  best grid found is written here.
+ * @param result  Where to describe the outcome; may be NULL.
+ * @return The status of the solve, as in enum sudoku_status.
+ */
+int sudoku_resolve(sudoku_solver *solver, const char *puzzle, char *solution,
+                   sudoku_result *result)
+{
+    return solveOne(solver, puzzle, solution, result, true);
+} // end sudoku_resolve(sudoku_solver*, char*, char*, sudoku_result*)
+
+/** Solve several puzzles. With more than one thread, the puzzles are shared
+ *  out among the solver's workers, and each puzzle's time limit starts when a
+ *  worker starts it. The results then depend on the seed but not on the
+ *  number of threads.
+ * @param solver  A solver from sudoku_solver_create().
+ * @param puzzles  count * SUDOKU_CELLS ASCII digits, back to back.
+ * @param count  The number of puzzles.
+ * @param solutions  Storage for count * SUDOKU_CELLS chars.
+ * @param results  Storage for count results; may be NULL.
+ * @return The number of puzzles that were solved.
+ */
+size_t sudoku_solve_batch(sudoku_solver *solver, const char *puzzles,
+                          size_t count, char *solutions,
+                          sudoku_result *results)
+{
+    size_t solved = 0;
+
+    if (solver != NULL && solver->batch != NULL && puzzles != NULL &&
+        solutions != NULL)
+    {
+        return solveShared(solver, puzzles, count, solutions, results);
+    } // end if (solver != NULL && solver->batch != NULL && ...)
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        int status = sudoku_solve(solver, puzzles + i * SUDOKU_CELLS,
+                                  solutions + i * SUDOKU_CELLS,
+                                  results != NULL ? results + i : NULL);
+        solved += status == SUDOKU_SOLVED;
+    } // end for (size_t i = 0; i < count; ++i)
+
+    return solved;
+} // end sudoku_solve_batch(sudoku_solver*, char*, size_t, char*, ...)
+
+/** Report how much population storage the calling thread has used. Storage
+ *  freed by one solve is kept for the next one on the same thread.
+ * @param in_use  Set to the bytes held by live populations; may be NULL.
+ * @param peak  Set to the most bytes ever held at once; may be NULL.
+ * @param retained  Set to the bytes kept for reuse; may be NULL.
+ */
+void sudoku_arena_stats(size_t *in_use, size_t *peak, size_t *retained)
+{
+    ArenaStats figures = ArenaPool::local().stats();
+
+    if (in_use != NULL)
+    {
+        *in_use = figures.inUse;
+    } // end if (in_use != NULL)
+
+    if (peak != NULL)
+    {
+        *peak = figures.peak;
+    } // end if (peak != NULL)
+
+    if (retained != NULL)
+    {
+        *retained = figures.retained;
+    } // end if (retained != NULL)
+} // end sudoku_arena_stats(size_t*, size_t*, size_t*)
+
+/** Release a solver. NULL is ignored.
+ * @param solver  A solver from sudoku_solver_create().
+ */
+void sudoku_solver_destroy(sudoku_solver *solver)
+{
+    if (solver != NULL)
+    {
+        delete solver->batch;
+        delete solver->cache;
+    } // end if (solver != NULL)
+
+    delete solver;
+} // end sudoku_solver_destroy(sudoku_solver*)
@@ -0,0 +1,161 @@
+/**
+ * @file    SudokuSolver.h
+ * @brief   A C interface to the genetic algorithm solver, for embedding it in
+ *          other programs instead of running the sudoku executable. Each
+ *          solver handle is independent, so separate threads may use separate
+ *          handles at the same time. Puzzles are passed as 81 ASCII digits in
+ *          row order, '0' marking an empty cell, and results are written to
+ *          buffers owned by the caller. Nothing here reads or writes a stream.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#ifndef _SUDOKUSOLVER_H
+#define	_SUDOKUSOLVER_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SUDOKU_CELLS 81
+
+/* Outcomes of a solve. The non-negative values match SolveStatus. */
+enum sudoku_status
+{
+    SUDOKU_INVALID = -1,                /* input was not 81 digits */
+    SUDOKU_SOLVED = 0,
+    SUDOKU_GENERATIONS_EXHAUSTED = 1,
+    SUDOKU_TIMED_OUT = 2,
+    SUDOKU_BUDGET_EXHAUSTED = 3,
+    SUDOKU_REJECTED = 4,                /* failed validation; see validity */
+    SUDOKU_CANCELLED = 5                /* stopped by the progress callback */
+};
+
+/* Told of each new best grid during a solve: SUDOKU_CELLS digits, not
+   null-terminated, with its fitness and generation. Return nonzero to let
+   the solve go on, or 0 to stop it as SUDOKU_CANCELLED. */
+typedef int (*sudoku_progress_fn)(void *context, const char *best,
+                                  int fitness, int generation);
+
+/* Verdicts of validation. The values match Validity. */
+enum sudoku_validity
+{
+    SUDOKU_UNIQUE = 0,
+    SUDOKU_CONFLICTING = 1,             /* clues repeat a digit */
+    SUDOKU_UNSOLVABLE = 2,
+    SUDOKU_AMBIGUOUS = 3                /* more than one solution */
+};
+
+/* Settings fixed when a solver is created. */
+typedef struct sudoku_params
+{
+    int pop_size;                       /* Puzzles per generation, >= 10 */
+    int max_gens;                       /* generations before giving up */
+    double seconds;                     /* per-puzzle time limit, 0 for none */
+    long max_evaluations;               /* per-puzzle budget, 0 for none */
+    long max_memory;                    /* per-puzzle bytes, 0 for none */
+    unsigned long long seed;            /* 0 picks one from the clock */
+    int validate;                       /* nonzero rejects bad puzzles first */
+    int threads;                        /* workers for sudoku_solve_batch() */
+    size_t cache_size;                  /* solutions to remember, 0 for none */
+    const char *cache_path;             /* file to keep them in, or NULL */
+    sudoku_progress_fn progress;        /* NULL for none; not called on the
+                                           workers of sudoku_solve_batch() */
+    void *progress_context;             /* passed to progress */
+    double mutation;                    /* chance a child's cell changes */
+    double survival;                    /* share of each generation kept */
+    int children;                       /* children bred per survivor */
+} sudoku_params;
+
+/* The outcome of solving one puzzle. */
+typedef struct sudoku_result
+{
+    int status;                         /* one of enum sudoku_status */
+    int fitness;                        /* 81 for a true solution */
+    int generations;
+    long evaluations;
+    int validity;                       /* one of enum sudoku_validity */
+} sudoku_result;
+
+typedef struct sudoku_solver sudoku_solver;
+
+/** Fill in the default settings: 750 Puzzles, 30000 generations, no limits,
+ *  validation on, one thread, no cache, no progress callback, and a mutation
+ *  rate of 0.05 with a tenth of each generation kept to breed 9 children
+ *  each.
+ * @param params  The settings to fill in.
+ */
+void sudoku_params_init(sudoku_params *params);
+
+/** Create a solver.
+ * @param params  Its settings, or NULL for the defaults.
+ * @return A new solver, or NULL if the settings are unusable, the cache file
+ *         cannot be opened or memory ran out. Release it with
+ *         sudoku_solver_destroy().
+ */
+sudoku_solver *sudoku_solver_create(const sudoku_params *params);
+
+/** Solve one puzzle. A solver with a cache answers a puzzle equivalent to
+ *  one it has solved before without solving it again, reporting it SOLVED in
+ *  no generations. With validation on, the puzzle is still checked first,
+ *  whatever run cached its solution.
+ * @param solver  A solver from sudoku_solver_create().
+ * @param puzzle  SUDOKU_CELLS ASCII digits.
+ * @param solution  Storage for SUDOKU_CELLS chars, not null-terminated. The
+ *                  best grid found is written here.
+ * @param result  Where to describe the outcome; may be NULL.
+ * @return The status of the solve, as in enum sudoku_status.
+ */
+int sudoku_solve(sudoku_solver *solver, const char *puzzle, char *solution,
+                 sudoku_result *result);
+
+/** Solve a puzzle again after it has gained clues, such as after a move in an
+ *  interactive game. The run starts from the population left by the
+ *  solver's latest solve, repaired to fit the new clues, rather than from
+ *  random grids, so a puzzle that has moved on only a little is solved in a
+ *  fraction of the time. With no earlier solve, this is sudoku_solve().
+ * @param solver  A solver from sudoku_solver_create().
+ * @param puzzle  SUDOKU_CELLS ASCII digits.
+ * @param solution  Storage for SUDOKU_CELLS chars, not null-terminated. The
+ *                  best grid found is written here.
+ * @param result  Where to describe the outcome; may be NULL.
+ * @return The status of the solve, as in enum sudoku_status.
+ */
+int sudoku_resolve(sudoku_solver *solver, const char *puzzle, char *solution,
+                   sudoku_result *result);
+
+/** Solve several puzzles. With more than one thread, the puzzles are shared
+ *  out among the solver's workers, and each puzzle's time limit starts when
+ *  a worker starts it. The results then depend on the seed but not on the
+ *  number of threads.
+ * @param solver  A solver from sudoku_solver_create().
+ * @param puzzles  count * SUDOKU_CELLS ASCII digits, back to back.
+ * @param count  The number of puzzles.
+ * @param solutions  Storage for count * SUDOKU_CELLS chars.
+ * @param results  Storage for count results; may be NULL.
+ * @return The number of puzzles that were solved.
+ */
+size_t sudoku_solve_batch(sudoku_solver *solver, const char *puzzles,
+                          size_t count, char *solutions,
+                          sudoku_result *results);
+
+/** Report how much population storage the calling thread has used. Storage
+ *  freed by one solve is kept for the next one on the same thread.
+ * @param in_use  Set to the bytes held by live populations; may be NULL.
+ * @param peak  Set to the most bytes ever held at once; may be NULL.
+ * @param retained  Set to the bytes kept for reuse; may be NULL.
+ */
+void sudoku_arena_stats(size_t *in_use, size_t *peak, size_t *retained);
+
+/** Release a solver. NULL is ignored.
+ * @param solver  A solver from sudoku_solver_create().
+ */
+void sudoku_solver_destroy(sudoku_solver *solver);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* _SUDOKUSOLVER_H */
@@ -0,0 +1,332 @@
+/**
+ * @file    Symmetry.cpp
+ * @brief   The changes that turn one Sudoku grid into an equivalent one:
+ *          transposing it, reordering the bands of rows and the rows within
+ *          each band, reordering the stacks of columns and the columns within
+ *          each stack, and relabelling the digits. A puzzle is solved exactly
+ *          when any of its equivalents is, so each class of equivalent
+ *          puzzles is represented by one canonical form: the least of its
+ *          members in reading order, '0' before any digit. canonicalize()
+ *          finds it row by row, keeping only the orderings that tie for the
+ *          least prefix, and returns the change that produces it so that an
+ *          answer for the canonical form can be carried back. Grids are plain
+ *          arrays of ROWS * COLUMNS ASCII digits, '0' marking an empty cell.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#include <cstring>
+#include <vector>
+
+#include "Symmetry.h"
+
+static const int ORDERS = 1296;         // 3! stacks * (3!)^3 columns
+static const size_t MOST_TIES = 200000; // orderings kept before giving up
+
+
+/** Every order of columns that keeps each stack together, 6 * 6 * 6 * 6.
+ */
+struct ColumnOrders
+{
+    unsigned char order[ORDERS][COLUMNS];
+
+    /** Default constructor. Lists the orders.
+     */
+    ColumnOrders()
+    {
+        static const int PERMUTE[6][3] = { { 0, 1, 2 }, { 0, 2, 1 },
+                                           { 1, 0, 2 }, { 1, 2, 0 },
+                                           { 2, 0, 1 }, { 2, 1, 0 } };
+        int n = 0;
+
+        for (int stacks = 0; stacks < 6; ++stacks)
+        {
+            for (int a = 0; a < 6; ++a)
+            {
+                for (int b = 0; b < 6; ++b)
+                {
+                    for (int c = 0; c < 6; ++c)
+                    {
+                        const int *within[3] = { PERMUTE[a], PERMUTE[b],
+                                                 PERMUTE[c] };
+
+                        for (int i = 0; i < COLUMNS; ++i)
+                        {
+                            order[n][i] = PERMUTE[stacks][i / 3] * 3 +
+                                          within[i / 3][i % 3];
+                        } // end for (int i = 0; i < COLUMNS; ++i)
+
+                        ++n;
+                    } // end for (int c = 0; c < 6; ++c)
+                } // end for (int b = 0; b < 6; ++b)
+            } // end for (int a = 0; a < 6; ++a)
+        } // end for (int stacks = 0; stacks < 6; ++stacks)
+    } // end default constructor
+};
+
+
+/** An ordering under consideration: rows chosen so far, with the labels they
+ *  have used.
+ */
+struct Partial
+{
+    unsigned char rows[ROWS];
+    unsigned char transposed;
+    unsigned short order;               // index into ColumnOrders
+    char labels[10];                    // 0 for a digit not yet labelled
+    char next;                          // the next label to give out
+};
+
+
+/** Label one row of a grid under an ordering, extending its labels.
+ * @param grid  The grid, already transposed if the ordering says so.
+ * @param row  The row of grid to take.
+ * @param columns  The order in which to take its cells.
+ * @param candidate  The ordering; its labels are extended.
+ * @param out  Storage for COLUMNS chars; set to the labelled row.
+ * @pre None.
+ * @post None.
+ */
+static void labelRow(const char *grid, int row, const unsigned char *columns,
+                     Partial& candidate, char *out)
+{
+    for (int i = 0; i < COLUMNS; ++i)
+    {
+        char digit = grid[row * COLUMNS + columns[i]];
+
+        if (digit == '0')
+        {
+            out[i] = '0';
+        }
+        else
+        {
+            char& label = candidate.labels[digit - '0'];
+
+            if (label == 0)
+            {
+                label = candidate.next++;
+            } // end if (label == 0)
+
+            out[i] = label;
+        } // end if (digit == '0')
+    } // end for (int i = 0; i < COLUMNS; ++i)
+} // end labelRow(char*, int, unsigned char*, Partial&, char*)
+
+/** Keep an extended ordering if its newest row is no greater than the least
+ *  seen at this depth.
+ * @param candidate  The extended ordering.
+ * @param row  Its newest row, labelled.
+ * @param least  The least row seen at this depth; lowered if row is less.
+ * @param kept  The orderings tied for least; emptied if row is less.
+ * @pre None.
+ * @post None.
+ */
+static void consider(const Partial& candidate, const char *row, char *least,
+                     vector<Partial>& kept)
+{
+    int order = memcmp(row, least, COLUMNS);
+
+    if (order < 0)
+    {
+        memcpy(least, row, COLUMNS);
+        kept.clear();
+    } // end if (order < 0)
+
+    if (order <= 0)
+    {
+        kept.push_back(candidate);
+    } // end if (order <= 0)
+} // end consider(Partial&, char*, char*, vector<Partial>&)
+
+
+/** Default constructor. The identity, which changes nothing.
+ */
+Symmetry::Symmetry() : transposed(false)
+{
+    for (int i = 0; i < ROWS; ++i)
+    {
+        rows[i] = columns[i] = i;
+    } // end for (int i = 0; i < ROWS; ++i)
+
+    for (int i = 0; i < 10; ++i)
+    {
+        labels[i] = '0' + i;
+    } // end for (int i = 0; i < 10; ++i)
+} // end default constructor
+
+/** Find the canonical form of a grid, and the change that produces it.
+ * @param cells  The grid.
+ * @param canonical  Storage for ROWS * COLUMNS chars; set to the canonical
+ *                   form of cells on success.
+ * @param change  Set on success to a change that takes cells to canonical.
+ *                Digits absent from cells are given the labels left over, in
+ *                order, so that a solution can be carried both ways.
+ * @pre None.
+ * @post None.
+ * @return true on success. false for a grid so nearly empty that too many
+ *         orderings tie; such a grid is best solved directly.
+ */
+bool Symmetry::canonicalize(const char *cells, char *canonical,
+                            Symmetry& change)
+{
+    static const ColumnOrders orders;
+    char grids[2][ROWS * COLUMNS];
+    vector<Partial> kept, extended;
+    char least[COLUMNS], row[COLUMNS];
+
+    for (int i = 0; i < ROWS * COLUMNS; ++i)
+    {
+        grids[0][i] = cells[i];
+        grids[1][(i % COLUMNS) * COLUMNS + i / COLUMNS] = cells[i];
+    } // end for (int i = 0; i < ROWS * COLUMNS; ++i)
+
+    // The first row may be any row of either grid, in any column order.
+    memset(least, '9' + 1, COLUMNS);
+
+    for (int t = 0; t < 2; ++t)
+    {
+        for (int first = 0; first < ROWS; ++first)
+        {
+            for (int order = 0; order < ORDERS; ++order)
+            {
+                Partial candidate;
+
+                memset(&candidate, 0, sizeof(candidate));
+                candidate.rows[0] = first;
+                candidate.transposed = t;
+                candidate.order = order;
+                candidate.next = '1';
+                labelRow(grids[t], first, orders.order[order], candidate,
+                         row);
+                consider(candidate, row, least, kept);
+            } // end for (int order = 0; order < ORDERS; ++order)
+        } // end for (int first = 0; first < ROWS; ++first)
+    } // end for (int t = 0; t < 2; ++t)
+
+    memcpy(canonical, least, COLUMNS);
+
+    // Each later row comes from the band in progress, or starts a new band.
+    for (int depth = 1; depth < ROWS; ++depth)
+    {
+        memset(least, '9' + 1, COLUMNS);
+        extended.clear();
+
+        for (size_t k = 0; k < kept.size(); ++k)
+        {
+            const Partial& base = kept[k];
+            bool used[ROWS] = { false };
+
+            for (int i = 0; i < depth; ++i)
+            {
+                used[base.rows[i] / 3 * 3] |= depth % 3 == 0;
+                used[base.rows[i]] = true;
+            } // end for (int i = 0; i < depth; ++i)
+
+            for (int next = 0; next < ROWS; ++next)
+            {
+                bool fits = depth % 3 == 0 ?
+                            !used[next / 3 * 3] :
+                            next / 3 == base.rows[depth - 1] / 3 &&
+                            !used[next];
+
+                if (fits)
+                {
+                    Partial candidate = base;
+
+                    candidate.rows[depth] = next;
+                    labelRow(grids[base.transposed], next,
+                             orders.order[base.order], candidate, row);
+                    consider(candidate, row, least, extended);
+                } // end if (fits)
+            } // end for (int next = 0; next < ROWS; ++next)
+        } // end for (size_t k = 0; k < kept.size(); ++k)
+
+        if (extended.size() > MOST_TIES)
+        {
+            return false;
+        } // end if (extended.size() > MOST_TIES)
+
+        memcpy(canonical + depth * COLUMNS, least, COLUMNS);
+        kept.swap(extended);
+    } // end for (int depth = 1; depth < ROWS; ++depth)
+
+    // Any ordering left gives the canonical form; the digits not seen take
+    // the labels not used.
+    Partial& chosen = kept[0];
+
+    for (int digit = 1; digit <= 9; ++digit)
+    {
+        if (chosen.labels[digit] == 0)
+        {
+            chosen.labels[digit] = chosen.next++;
+        } // end if (chosen.labels[digit] == 0)
+    } // end for (int digit = 1; digit <= 9; ++digit)
+
+    change.transposed = chosen.transposed != 0;
+    memcpy(change.rows, chosen.rows, ROWS);
+    memcpy(change.columns, orders.order[chosen.order], COLUMNS);
+    change.labels[0] = '0';
+    memcpy(change.labels + 1, chosen.labels + 1, 9);
+
+    return true;
+} // end canonicalize(char*, char*, Symmetry&)
+
+/** Apply this change to a grid.
+ * @param cells  The grid.
+ * @param result  Storage for ROWS * COLUMNS chars; set to the changed grid.
+ *                Must not overlap cells.
+ * @pre None.
+ * @post None.
+ */
+void Symmetry::apply(const char *cells, char *result) const
+{
+    for (int r = 0; r < ROWS; ++r)
+    {
+        for (int c = 0; c < COLUMNS; ++c)
+        {
+            result[r * COLUMNS + c] = labels[cells[source(r, c)] - '0'];
+        } // end for (int c = 0; c < COLUMNS; ++c)
+    } // end for (int r = 0; r < ROWS; ++r)
+} // end apply(char*, char*)
+
+/** Undo this change on a grid.
+ * @param cells  A grid produced by apply(), or one equivalent to it.
+ * @param result  Storage for ROWS * COLUMNS chars; set to the grid that
+ *                apply() would take to cells. Must not overlap cells.
+ * @pre None.
+ * @post None.
+ */
+void Symmetry::undo(const char *cells, char *result) const
+{
+    char digits[10];
+
+    for (int i = 0; i < 10; ++i)
+    {
+        digits[labels[i] - '0'] = '0' + i;
+    } // end for (int i = 0; i < 10; ++i)
+
+    for (int r = 0; r < ROWS; ++r)
+    {
+        for (int c = 0; c < COLUMNS; ++c)
+        {
+            result[source(r, c)] = digits[cells[r * COLUMNS + c] - '0'];
+        } // end for (int c = 0; c < COLUMNS; ++c)
+    } // end for (int r = 0; r < ROWS; ++r)
+} // end undo(char*, char*)
+
+/** Find the cell of the source grid that a cell of the result comes from.
+ * @param row  The row in the result.
+ * @param column  The column in the result.
+ * @pre None.
+ * @post None.
+ * @return The index of the source cell.
+ */
+int Symmetry::source(int row, int column) const
+{
+    if (transposed)
+    {
+        return columns[column] * COLUMNS + rows[row];
+    } // end if (transposed)
+
+    return rows[row] * COLUMNS + columns[column];
+} // end source(int, int)
@@ -0,0 +1,86 @@
+/**
+ * @file    Symmetry.h
+ * @brief   The changes that turn one Sudoku grid into an equivalent one:
+ *          transposing it, reordering the bands of rows and the rows within
+ *          each band, reordering the stacks of columns and the columns within
+ *          each stack, and relabelling the digits. A puzzle is solved exactly
+ *          when any of its equivalents is, so each class of equivalent
+ *          puzzles is represented by one canonical form: the least of its
+ *          members in reading order, '0' before any digit. canonicalize()
+ *          finds it row by row, keeping only the orderings that tie for the
+ *          least prefix, and returns the change that produces it so that an
+ *          answer for the canonical form can be carried back. Grids are plain
+ *          arrays of ROWS * COLUMNS ASCII digits, '0' marking an empty cell.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#ifndef _SYMMETRY_H
+#define	_SYMMETRY_H
+
+#include "Puzzle.h"
+
+using namespace std;
+
+
+class Symmetry
+{
+public:
+
+    /** Default constructor. The identity, which changes nothing.
+     */
+    Symmetry();
+
+    /** Find the canonical form of a grid, and the change that produces it.
+     * @param cells  The grid.
+     * @param canonical  Storage for ROWS * COLUMNS chars; set to the
+     *                   canonical form of cells on success.
+     * @param change  Set on success to a change that takes cells to
+     *                canonical. Digits absent from cells are given the
+     *                labels left over, in order, so that a solution can be
+     *                carried both ways.
+     * @pre None.
+     * @post None.
+     * @return true on success. false for a grid so nearly empty that too many
+     *         orderings tie; such a grid is best solved directly.
+     */
+    static bool canonicalize(const char *cells, char *canonical,
+                             Symmetry& change);
+
+    /** Apply this change to a grid.
+     * @param cells  The grid.
+     * @param result  Storage for ROWS * COLUMNS chars; set to the changed
+     *                grid. Must not overlap cells.
+     * @pre None.
+     * @post None.
+     */
+    void apply(const char *cells, char *result) const;
+
+    /** Undo this change on a grid.
+     * @param cells  A grid produced by apply(), or one equivalent to it.
+     * @param result  Storage for ROWS * COLUMNS chars; set to the grid that
+     *                apply() would take to cells. Must not overlap cells.
+     * @pre None.
+     * @post None.
+     */
+    void undo(const char *cells, char *result) const;
+
+private:
+
+    bool transposed;                    // rows and columns swap first
+    unsigned char rows[ROWS];           // source row of each row
+    unsigned char columns[COLUMNS];     // source column of each column
+    char labels[10];                    // new char for each digit, by value
+
+    /** Find the cell of the source grid that a cell of the result comes from.
+     * @param row  The row in the result.
+     * @param column  The column in the result.
+     * @pre None.
+     * @post None.
+     * @return The index of the source cell.
+     */
+    int source(int row, int column) const;
+
+};
+
+#endif	/* _SYMMETRY_H */
@@ -0,0 +1,221 @@
+/**
+ * @file    WorkStealingPool.cpp
+ * @brief   A fixed set of worker threads, each with its own deque of tasks.
+ *          A worker takes its newest task from the back of its own deque and,
+ *          when that is empty, steals the oldest task from the front of
+ *          another worker's deque. A task may ask to be run again, which lets
+ *          a long job be cut into slices that move to whichever worker is
+ *          idle, instead of holding one worker while the others wait.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#include "WorkStealingPool.h"
+
+
+/** Destructor.
+ */
+Task::~Task()
+{
+} // end destructor
+
+/** Constructor. Starts the workers, which wait for tasks.
+ * @param workers  The number of worker threads, at least 1.
+ */
+WorkStealingPool::WorkStealingPool(int workers) : queues(), threads(),
+                                                  outstanding(0), stolen(0),
+                                                  stopping(false), batch(),
+                                                  idle(), wake()
+{
+    for (int i = 0; i < workers; ++i)
+    {
+        queues.push_back(new Queue);
+    } // end for (int i = 0; i < workers; ++i)
+
+    for (int i = 0; i < workers; ++i)
+    {
+        threads.push_back(thread(&WorkStealingPool::work, this, i));
+    } // end for (int i = 0; i < workers; ++i)
+} // end constructor
+
+/** Destructor. Stops the workers.
+ * @pre No call to runAll() is in progress.
+ */
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        lock_guard<mutex> guard(idle);
+        stopping = true;
+    }
+
+    wake.notify_all();
+
+    for (size_t i = 0; i < threads.size(); ++i)
+    {
+        threads[i].join();
+    } // end for (size_t i = 0; i < threads.size(); ++i)
+
+    // Only now, since a worker still running may look into any deque.
+    for (size_t i = 0; i < queues.size(); ++i)
+    {
+        delete queues[i];
+    } // end for (size_t i = 0; i < queues.size(); ++i)
+} // end destructor
+
+/** Run every task to completion, spread across the workers.
+ * @param tasks  The tasks, which are not owned and must outlive the call.
+ * @pre No other call to runAll() is in progress.
+ * @post Every task has returned false from run().
+ */
+void WorkStealingPool::runAll(const vector<Task*>& tasks)
+{
+    lock_guard<mutex> exclusive(batch);
+
+    if (tasks.empty())
+    {
+        return;
+    } // end if (tasks.empty())
+
+    // Deal the tasks out evenly; stealing evens out whatever the deal did
+    // not. They are counted once dealt, so that a worker that found nothing
+    // before the deal sees the count change and looks again.
+    for (size_t i = 0; i < tasks.size(); ++i)
+    {
+        Queue& queue = *queues[i % queues.size()];
+        lock_guard<mutex> guard(queue.lock);
+
+        queue.tasks.push_back(tasks[i]);
+    } // end for (size_t i = 0; i < tasks.size(); ++i)
+
+    outstanding += tasks.size();
+
+    {
+        lock_guard<mutex> guard(idle);
+    }
+
+    wake.notify_all();
+
+    unique_lock<mutex> guard(idle);
+
+    while (outstanding > 0)
+    {
+        wake.wait(guard);
+    } // end while (outstanding > 0)
+} // end runAll(vector<Task*>&)
+
+/** Provide the number of worker threads.
+ * @pre None.
+ * @post None.
+ * @return The number of workers.
+ */
+int WorkStealingPool::size(void) const
+{
+    return threads.size();
+} // end size()
+
+/** Provide the number of tasks taken from another worker's deque.
+ * @pre None.
+ * @post None.
+ * @return The count of steals since construction.
+ */
+long WorkStealingPool::steals(void) const
+{
+    return stolen;
+} // end steals()
+
+/** Take tasks and run them until the pool is destroyed.
+ * @param index  Which worker this is.
+ * @pre None.
+ * @post None.
+ */
+void WorkStealingPool::work(int index)
+{
+    unsigned victim = index + 1;
+
+    while (true)
+    {
+        long seen = outstanding;    // read first, so no change is missed
+        Task *task = take(index, victim);
+
+        if (task != NULL)
+        {
+            if (task->run(index))   // more to do; keep it close at hand
+            {
+                lock_guard<mutex> guard(queues[index]->lock);
+
+                queues[index]->tasks.push_back(task);
+            }
+            else
+            {
+                --outstanding;
+
+                lock_guard<mutex> guard(idle);
+
+                wake.notify_all();
+            } // end if (task->run(index))
+        }
+        else
+        {
+            // Nothing is queued: every task left is being run, or there are
+            // none. A task queued again goes back to the worker running it,
+            // so nothing can be stolen until a task finishes or a batch
+            // arrives; sleeping until then leaves the core to those at work.
+            unique_lock<mutex> guard(idle);
+
+            while (outstanding == seen && !stopping)
+            {
+                wake.wait(guard);
+            } // end while (outstanding == seen && !stopping)
+
+            if (stopping)
+            {
+                break;
+            } // end if (stopping)
+        } // end if (task != NULL)
+    } // end while (true)
+} // end work(int)
+
+/** Find a task for a worker: its own newest, or another's oldest.
+ * @param index  Which worker is looking.
+ * @param victim  Where to start looking in other deques.
+ * @pre None.
+ * @post None.
+ * @return A task, or NULL if every deque is empty.
+ */
+Task *WorkStealingPool::take(int index, unsigned& victim)
+{
+    Task *task = NULL;
+
+    {
+        lock_guard<mutex> guard(queues[index]->lock);
+
+        if (!queues[index]->tasks.empty())
+        {
+            task = queues[index]->tasks.back();
+            queues[index]->tasks.pop_back();
+            return task;
+        } // end if (!queues[index]->tasks.empty())
+    }
+
+    for (size_t tries = 1; tries < queues.size(); ++tries, ++victim)
+    {
+        Queue& other = *queues[victim % queues.size()];
+
+        if (&other == queues[index])
+        {
+            continue;
+        } // end if (&other == queues[index])
+
+        lock_guard<mutex> guard(other.lock);
+
+        if (!other.tasks.empty())
+        {
+            task = other.tasks.front();
+            other.tasks.pop_front();
+            ++stolen;
+            return task;
+        } // end if (!other.tasks.empty())
+    } // end for (size_t tries = 1; tries < queues.size(); ++tries, ++victim)
+
+    return NULL;
+} // end take(int, unsigned&)
@@ -0,0 +1,126 @@
+/**
+ * @file    WorkStealingPool.h
+ * @brief   A fixed set of worker threads, each with its own deque of tasks.
+ *          A worker takes its newest task from the back of its own deque and,
+ *          when that is empty, steals the oldest task from the front of
+ *          another worker's deque. A task may ask to be run again, which lets
+ *          a long job be cut into slices that move to whichever worker is
+ *          idle, instead of holding one worker while the others wait.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#ifndef _WORKSTEALINGPOOL_H
+#define	_WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+
+/** A unit of work for a WorkStealingPool.
+ */
+class Task
+{
+public:
+
+    /** Destructor.
+     */
+    virtual ~Task();
+
+    /** Do one slice of this task's work.
+     * @param worker  The index of the worker running the slice.
+     * @pre None.
+     * @post None.
+     * @return true if the task has more to do and should be run again,
+     *         false if it is finished.
+     */
+    virtual bool run(int worker) = 0;
+
+};
+
+
+class WorkStealingPool
+{
+public:
+
+    /** Constructor. Starts the workers, which wait for tasks.
+     * @param workers  The number of worker threads, at least 1.
+     */
+    explicit WorkStealingPool(int workers);
+
+    /** Destructor. Stops the workers.
+     * @pre No call to runAll() is in progress.
+     */
+    virtual ~WorkStealingPool();
+
+    /** Run every task to completion, spread across the workers.
+     * @param tasks  The tasks, which are not owned and must outlive the call.
+     * @pre No other call to runAll() is in progress.
+     * @post Every task has returned false from run().
+     */
+    void runAll(const vector<Task*>& tasks);
+
+    /** Provide the number of worker threads.
+     * @pre None.
+     * @post None.
+     * @return The number of workers.
+     */
+    int size(void) const;
+
+    /** Provide the number of tasks taken from another worker's deque.
+     * @pre None.
+     * @post None.
+     * @return The count of steals since construction.
+     */
+    long steals(void) const;
+
+private:
+
+    /** One worker's deque, padded so neighbouring locks do not share a
+     *  cache line.
+     */
+    struct Queue
+    {
+        mutex lock;
+        deque<Task*> tasks;
+        char pad[64];
+    };
+
+    vector<Queue*> queues;
+    vector<thread> threads;
+    atomic<long> outstanding;   // tasks given to runAll() and not finished
+    atomic<long> stolen;
+    atomic<bool> stopping;
+    mutex batch;                // held by runAll() for a whole call
+    mutex idle;                 // guards sleeping and waking only
+    condition_variable wake;    // work has arrived, or a task has finished
+
+    /** Take tasks and run them until the pool is destroyed.
+     * @param index  Which worker this is.
+     * @pre None.
+     * @post None.
+     */
+    void work(int index);
+
+    /** Find a task for a worker: its own newest, or another's oldest.
+     * @param index  Which worker is looking.
+     * @param victim  Where to start looking in other deques.
+     * @pre None.
+     * @post None.
+     * @return A task, or NULL if every deque is empty.
+     */
+    Task *take(int index, unsigned& victim);
+
+    // Not copyable; the pool owns threads.
+    WorkStealingPool(const WorkStealingPool& orig);
+    void operator=(const WorkStealingPool& rhs);
+
+};
+
+#endif	/* _WORKSTEALINGPOOL_H */
@@ -0,0 +1,425 @@
+/**
+ * @file    bench.cpp
+ * @brief   This program measures the solver on corpora of puzzles, such as
+ *          those written by the generate program, and reports the results
+ *          for each difficulty tier separately. With --scaling, it instead
+ *          solves the whole corpus as one batch on 1, 2, 4, ... threads, each
+ *          run bounded by --gens alone, and reports throughput and speedup
+ *          against one thread, answering repeated puzzles from a solution
+ *          cache if --cache is given. With --copies, it measures how fast
+ *          Puzzles are copied, moved and sorted, and with --render, how fast
+ *          results are written out. With --results, the outcome of every
+ *          solve is also written to a file, in corpus order, through a
+ *          ResultWriter in the format chosen by --format.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <utility>
+
+#include "BatchSolver.h"
+#include "Corpus.h"
+#include "GeneticAlgorithm.h"
+#include "Options.h"
+#include "PuzzleGenerator.h"
+#include "ResultWriter.h"
+
+using namespace std;
+
+
+/** Solve a corpus as one batch on more and more threads, and report how the
+ *  throughput grows.
+ * @param corpus  The puzzles.
+ * @param most  The largest number of threads to try.
+ * @param popSize  Size of the population to have each generation.
+ * @param maxGens  Maximum number of generations before giving up. This is
+ *                 the only limit on a run; a deadline would end more runs
+ *                 early the more threads share a core, and so change the
+ *                 work being timed.
+ * @param seed  Seeds the batch; every thread count solves the same runs.
+ * @param cached  Solutions each thread count may cache; 0 for no cache.
+ * @pre None.
+ * @post A table has been written to standard output.
+ */
+static void scaling(const vector<Puzzle>& corpus, int most, int popSize,
+                    int maxGens, uint64_t seed, int cached)
+{
+    double baseline = 0.0;
+
+    printf("%8s %8s %12s %12s %10s %10s %8s %8s\n", "threads", "solved",
+           "wall ms", "puzzles/s", "speedup", "efficiency", "steals",
+           "reused");
+
+    for (int threads = 1; threads <= most; threads *= 2)
+    {
+        BatchSolver solver(threads, popSize, maxGens, 50);
+        SolutionCache cache(cached);
+
+        if (cached > 0)
+        {
+            solver.cacheWith(&cache);
+        } // end if (cached > 0)
+
+        vector<SolveResult> results;
+        SolveLimits::Clock::time_point start = SolveLimits::Clock::now();
+        size_t solved = solver.solve(corpus, SolveLimits(), 0.0, seed,
+                                     results);
+        double wall = chrono::duration<double, milli>(
+            SolveLimits::Clock::now() - start).count();
+
+        if (threads == 1)
+        {
+            baseline = wall;
+        } // end if (threads == 1)
+
+        printf("%8d %8zu %12.1f %12.1f %10.2f %9.0f%% %8ld %8ld\n",
+               threads, solved, wall, corpus.size() * 1000.0 / wall,
+               baseline / wall, 100.0 * baseline / wall / threads,
+               solver.steals(), solver.answered());
+
+        if (threads < most && threads * 2 > most)
+        {
+            threads = most / 2;     // finish on the count that was asked for
+        } // end if (threads < most && threads * 2 > most)
+    } // end for (int threads = 1; threads <= most; threads *= 2)
+} // end scaling(vector<Puzzle>&, int, int, int, uint64_t, int)
+
+
+/** Orders scored Puzzles best first, as selection does.
+ */
+struct ByFitness
+{
+    bool operator()(const pair<int, Puzzle>& lhs,
+                    const pair<int, Puzzle>& rhs) const
+    {
+        return lhs.first > rhs.first;
+    } // end operator()(pair<int, Puzzle>&, pair<int, Puzzle>&)
+};
+
+
+/** Time copying, growing and sorting a large set of Puzzles built from a
+ *  corpus, and report the rate of each.
+ * @param corpus  The puzzles, repeated to fill the set.
+ * @param count  The number of Puzzles in the set.
+ * @pre corpus is not empty.
+ * @post A table has been written to standard output.
+ */
+static void copying(const vector<Puzzle>& corpus, int count)
+{
+    const int ROUNDS = 10;
+    vector<Puzzle> set;
+    vector<pair<int, Puzzle> > scored;
+    double wall[3] = { 0.0, 0.0, 0.0 };
+    const char *names[3] = { "copy", "grow", "sort" };
+    Random shuffle(1);
+
+    for (int i = 0; i < count; ++i)
+    {
+        set.push_back(corpus[i % corpus.size()]);
+    } // end for (int i = 0; i < count; ++i)
+
+    for (int round = 0; round < ROUNDS; ++round)
+    {
+        SolveLimits::Clock::time_point start = SolveLimits::Clock::now();
+        vector<Puzzle> copy(set);
+
+        wall[0] += chrono::duration<double, milli>(
+            SolveLimits::Clock::now() - start).count();
+
+        // Growing without reserve() moves every Puzzle log2(count) times.
+        start = SolveLimits::Clock::now();
+        vector<Puzzle> grown;
+
+        for (int i = 0; i < count; ++i)
+        {
+            grown.push_back(copy[i]);
+        } // end for (int i = 0; i < count; ++i)
+
+        wall[1] += chrono::duration<double, milli>(
+            SolveLimits::Clock::now() - start).count();
+
+        // Scores are drawn at random so that the sort times moves alone.
+        scored.clear();
+
+        for (int i = 0; i < count; ++i)
+        {
+            scored.push_back(make_pair(static_cast<int>(shuffle.below(217)),
+                                       grown[i]));
+        } // end for (int i = 0; i < count; ++i)
+
+        start = SolveLimits::Clock::now();
+        sort(scored.begin(), scored.end(), ByFitness());
+        wall[2] += chrono::duration<double, milli>(
+            SolveLimits::Clock::now() - start).count();
+    } // end for (int round = 0; round < ROUNDS; ++round)
+
+    printf("%-8s %10s %12s %14s\n", "test", "puzzles", "mean ms",
+           "Mpuzzles/s");
+
+    for (int i = 0; i < 3; ++i)
+    {
+        printf("%-8s %10d %12.3f %14.2f\n", names[i], count, wall[i] / ROUNDS,
+               count * ROUNDS / wall[i] / 1000.0);
+    } // end for (int i = 0; i < 3; ++i)
+} // end copying(vector<Puzzle>&, int)
+
+
+/** Time writing results built from a corpus to /dev/null, through
+ *  operator<< and through a ResultWriter in each format, and report the rate
+ *  of each.
+ * @param corpus  The puzzles, repeated to fill the set.
+ * @param count  The number of results to write.
+ * @pre corpus is not empty.
+ * @post A table has been written to standard output.
+ */
+static void rendering(const vector<Puzzle>& corpus, int count)
+{
+    const char *names[4] = { "stream", "line", "grid", "json" };
+    vector<SolveResult> results(count);
+    double wall[4];
+
+    for (int i = 0; i < count; ++i)
+    {
+        results[i].best = corpus[i % corpus.size()];
+        results[i].status = SOLVED;
+        results[i].generations = i % 1000;
+        results[i].evaluations = 750L * (i % 1000);
+        results[i].validity = UNIQUE;
+    } // end for (int i = 0; i < count; ++i)
+
+    {
+        ofstream sink("/dev/null");
+        SolveLimits::Clock::time_point start = SolveLimits::Clock::now();
+
+        for (int i = 0; i < count; ++i)
+        {
+            sink << results[i].best << '\n';
+        } // end for (int i = 0; i < count; ++i)
+
+        sink.flush();
+        wall[0] = chrono::duration<double, milli>(
+            SolveLimits::Clock::now() - start).count();
+    }
+
+    for (int format = LINE_FORMAT; format <= JSON_FORMAT; ++format)
+    {
+        FILE *sink = fopen("/dev/null", "w");
+        SolveLimits::Clock::time_point start = SolveLimits::Clock::now();
+
+        {
+            ResultWriter writer(sink, static_cast<ResultFormat>(format));
+
+            for (int i = 0; i < count; ++i)
+            {
+                writer.add(results[i]);
+            } // end for (int i = 0; i < count; ++i)
+        }
+
+        wall[format + 1] = chrono::duration<double, milli>(
+            SolveLimits::Clock::now() - start).count();
+        fclose(sink);
+    } // end for (int format = LINE_FORMAT; format <= JSON_FORMAT; ++format)
+
+    printf("%-8s %10s %12s %14s\n", "format", "results", "ms",
+           "Mresults/s");
+
+    for (int i = 0; i < 4; ++i)
+    {
+        printf("%-8s %10d %12.3f %14.2f\n", names[i], count, wall[i],
+               count / wall[i] / 1000.0);
+    } // end for (int i = 0; i < 4; ++i)
+} // end rendering(vector<Puzzle>&, int)
+
+
+/*
+ * Usage: bench [--pop=N] [--gens=N] [--seconds=S] [--seed=N]
+ *              [--scaling=THREADS] [--cache=N] [--copies=N] [--render=N]
+ *              [--results=FILE] [--format=line|grid|json] FILE...
+ */
+int main(int argc, char** argv)
+{
+    int popSize = 750, maxGens = 30000, most = 0, cached = 0, copies = 0;
+    int render = 0;
+    double seconds = 10.0;
+    const char *results = NULL;     // where to write each outcome, if anywhere
+    ResultFormat format = LINE_FORMAT;
+    uint64_t seed = 1;
+    vector<Puzzle> corpus;
+    vector<double> millis[TIERS];
+    long generations[TIERS] = { 0 }, nodes[TIERS] = { 0 };
+    int solved[TIERS] = { 0 };
+    SolutionCounter counter;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char *value;
+        bool good;
+
+        if ((value = optionValue(argv[i], "--pop=")) != NULL)
+        {
+            good = parseCount(value, 10, popSize);
+        }
+        else if ((value = optionValue(argv[i], "--gens=")) != NULL)
+        {
+            good = parseCount(value, 1, maxGens);
+        }
+        else if ((value = optionValue(argv[i], "--seconds=")) != NULL)
+        {
+            good = parseSeconds(value, seconds);
+        }
+        else if ((value = optionValue(argv[i], "--seed=")) != NULL)
+        {
+            good = parseSeed(value, seed);
+        }
+        else if ((value = optionValue(argv[i], "--scaling=")) != NULL)
+        {
+            good = parseCount(value, 1, most);
+        }
+        else if ((value = optionValue(argv[i], "--cache=")) != NULL)
+        {
+            good = parseCount(value, 1, cached);
+        }
+        else if ((value = optionValue(argv[i], "--copies=")) != NULL)
+        {
+            good = parseCount(value, 1, copies);
+        }
+        else if ((value = optionValue(argv[i], "--render=")) != NULL)
+        {
+            good = parseCount(value, 1, render);
+        }
+        else if ((value = optionValue(argv[i], "--results=")) != NULL)
+        {
+            results = value;
+            good = *value != '\0';
+        }
+        else if ((value = optionValue(argv[i], "--format=")) != NULL)
+        {
+            good = ResultWriter::formatNamed(value, format);
+        }
+        else
+        {
+            good = readCorpus(argv[i], corpus);
+        } // end if ((value = optionValue(argv[i], "--pop=")) != NULL)
+
+        if (!good)
+        {
+            cerr << "Invalid argument: " << argv[i] << endl
+                 << "Usage: " << argv[0] << " [--pop=N] [--gens=N]"
+                 << " [--seconds=S] [--seed=N] [--scaling=THREADS]"
+                 << " [--cache=N] [--copies=N] [--render=N]"
+                 << " [--results=FILE] [--format=line|grid|json] FILE..."
+                 << endl;
+            return (EXIT_FAILURE);
+        } // end if (!good)
+    } // end for (int i = 1; i < argc; ++i)
+
+    if (copies > 0 && !corpus.empty())
+    {
+        copying(corpus, copies);
+        return (EXIT_SUCCESS);
+    } // end if (copies > 0 && !corpus.empty())
+
+    if (render > 0 && !corpus.empty())
+    {
+        rendering(corpus, render);
+        return (EXIT_SUCCESS);
+    } // end if (render > 0 && !corpus.empty())
+
+    if (most > 0)
+    {
+        scaling(corpus, most, popSize, maxGens, seed, cached);
+        return (EXIT_SUCCESS);
+    } // end if (most > 0)
+
+    Random seeds(seed);
+    FILE *out = NULL;
+    ResultWriter *writer = NULL;
+
+    if (results != NULL)
+    {
+        out = string(results) == "-" ? stdout : fopen(results, "w");
+
+        if (out == NULL)
+        {
+            cerr << "Cannot write " << results << endl;
+            return (EXIT_FAILURE);
+        } // end if (out == NULL)
+
+        writer = new ResultWriter(out, format);
+    } // end if (results != NULL)
+
+    for (size_t i = 0; i < corpus.size(); ++i)
+    {
+        Difficulty tier = PuzzleGenerator::grade(corpus[i]);
+        char cells[ROWS * COLUMNS];
+        GeneticAlgorithm engine(corpus[i], popSize, maxGens);
+        SolveLimits::Clock::time_point start = SolveLimits::Clock::now();
+
+        engine.seed(seeds.next());
+        SolveResult result = engine.evolve(SolveLimits::within(seconds));
+
+        millis[tier].push_back(chrono::duration<double, milli>(
+            SolveLimits::Clock::now() - start).count());
+        solved[tier] += result.status == SOLVED;
+        generations[tier] += result.generations;
+
+        corpus[i].write(cells);
+        counter.count(cells, 2);
+        nodes[tier] += counter.nodes();
+
+        if (writer != NULL)
+        {
+            writer->add(result);
+        } // end if (writer != NULL)
+    } // end for (size_t i = 0; i < corpus.size(); ++i)
+
+    if (writer != NULL)
+    {
+        bool written = writer->flush();
+
+        delete writer;
+
+        if (out != stdout)
+        {
+            written = fclose(out) == 0 && written;
+        } // end if (out != stdout)
+
+        if (!written)
+        {
+            cerr << "Cannot write " << results << endl;
+            return (EXIT_FAILURE);
+        } // end if (!written)
+    } // end if (writer != NULL)
+
+    printf("%-8s %8s %8s %12s %12s %12s %12s\n", "tier", "puzzles", "solved",
+           "median ms", "mean ms", "mean gens", "mean nodes");
+
+    for (int tier = 0; tier < TIERS; ++tier)
+    {
+        size_t count = millis[tier].size();
+        double total = 0.0;
+
+        if (count == 0)
+        {
+            continue;
+        } // end if (count == 0)
+
+        sort(millis[tier].begin(), millis[tier].end());
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            total += millis[tier][i];
+        } // end for (size_t i = 0; i < count; ++i)
+
+        printf("%-8s %8zu %8d %12.2f %12.2f %12.1f %12.1f\n",
+               PuzzleGenerator::name(static_cast<Difficulty>(tier)), count,
+               solved[tier], millis[tier][count / 2], total / count,
+               static_cast<double>(generations[tier]) / count,
+               static_cast<double>(nodes[tier]) / count);
+    } // end for (int tier = 0; tier < TIERS; ++tier)
+
+    return (EXIT_SUCCESS);
+}
@@ -0,0 +1,112 @@
+/**
+ * @file    generate.cpp
+ * @brief   This program writes a corpus of new puzzles, each with exactly one
+ *          solution, for benchmarking the solver. Puzzles are made either at
+ *          a given number of clues or in a given difficulty tier.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#include "Corpus.h"
+#include "Options.h"
+#include "PuzzleGenerator.h"
+
+using namespace std;
+
+
+/*
+ * Usage: generate [--count=N] [--tier=easy|medium|hard|expert | --clues=N]
+ *                 [--seed=N] [--asymmetric] [--binary] [--out=FILE]
+ */
+int main(int argc, char** argv)
+{
+    int count = 100, clues = 0;
+    uint64_t seed = 1;
+    Difficulty tier = MEDIUM;
+    bool symmetric = true, binary = false;
+    const char *out = "-";
+    vector<Puzzle> corpus;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char *value;
+        bool good = true;
+
+        if ((value = optionValue(argv[i], "--count=")) != NULL)
+        {
+            good = parseCount(value, 1, count);
+        }
+        else if ((value = optionValue(argv[i], "--tier=")) != NULL)
+        {
+            good = PuzzleGenerator::tierNamed(value, tier);
+        }
+        else if ((value = optionValue(argv[i], "--clues=")) != NULL)
+        {
+            good = parseCount(value, 17, clues) && clues <= ROWS * COLUMNS;
+        }
+        else if ((value = optionValue(argv[i], "--seed=")) != NULL)
+        {
+            good = parseSeed(value, seed);
+        }
+        else if ((value = optionValue(argv[i], "--out=")) != NULL)
+        {
+            out = value;
+        }
+        else if (string(argv[i]) == "--asymmetric")
+        {
+            symmetric = false;
+        }
+        else if (string(argv[i]) == "--binary")
+        {
+            binary = true;
+        }
+        else
+        {
+            good = false;
+        } // end if ((value = optionValue(argv[i], "--count=")) != NULL)
+
+        if (!good)
+        {
+            cerr << "Invalid argument: " << argv[i] << endl
+                 << "Usage: " << argv[0] << " [--count=N]"
+                 << " [--tier=easy|medium|hard|expert | --clues=N]"
+                 << " [--seed=N] [--asymmetric] [--binary] [--out=FILE]"
+                 << endl;
+            return (EXIT_FAILURE);
+        } // end if (!good)
+    } // end for (int i = 1; i < argc; ++i)
+
+    PuzzleGenerator maker(seed);
+    corpus.reserve(count);
+
+    // Very few clues may be out of reach of digging; give up in that case.
+    for (int misses = 0; static_cast<int>(corpus.size()) < count; ++misses)
+    {
+        Puzzle puzzle;
+
+        if (misses > 1000)
+        {
+            cerr << "Cannot dig down to " << clues << " clues" << endl;
+            return (EXIT_FAILURE);
+        } // end if (misses > 1000)
+
+        if (clues == 0)
+        {
+            corpus.push_back(maker.generate(tier, symmetric));
+            misses = -1;            // a tier always yields a puzzle
+        }
+        else if (maker.generate(clues, symmetric, puzzle))
+        {
+            corpus.push_back(puzzle);
+            misses = -1;
+        } // end if (clues == 0)
+    } // end for (int misses = 0; static_cast<int>(corpus.size()) < count; ...)
+
+    if (!writeCorpus(out, corpus, binary))
+    {
+        cerr << "Cannot write " << out << endl;
+        return (EXIT_FAILURE);
+    } // end if (!writeCorpus(out, corpus, binary))
+
+    return (EXIT_SUCCESS);
+}
@@ -8,27 +8,440 @@
  */
 
 #include "GeneticAlgorithm.h"
+#include "Islands.h"
+#include "Options.h"
+#include "Pipeline.h"
+#include "Profiler.h"
 
 using namespace std;
 
 const int POPSIZE = 750, MAXGENS = 30000;
 
 
+/** Prints each improvement to the best Puzzle of a run as it happens.
+ */
+class ProgressPrinter : public ProgressListener
+{
+public:
+
+    /** Hear of a new best Puzzle, and print its fitness.
+     * @param best  The most fit Puzzle so far.
+     * @param fitness  Its fitness.
+     * @param generation  The number of the generation that found it.
+     * @pre None.
+     * @post A line has been written to standard output.
+     * @return true; the run always goes on.
+     */
+    virtual bool improved(const Puzzle& /* best */, int fitness,
+                          int generation)
+    {
+        cout << "Generation " << generation << ": fitness " << fitness
+             << endl;
+
+        return true;
+    } // end improved(Puzzle&, int, int)
+
+};
+
+
 /*
- * 
+ * Usage: sudoku POPSIZE MAXGENS [SECONDS] [--checkpoint=FILE] [--every=N]
+ *               [--resume=FILE] [--warm=FILE] [--seed=N] [--replay=FILE]
+ *               [--verify=FILE] [--no-validate] [--threads=N] [--trace=FILE]
+ *               [--progress] [--mutation=P] [--survival=F] [--children=N]
+ *               [--islands=N] [--migrate=G]
+ *
+ * Puzzles whose clues conflict, or that have no solution or more than one,
+ * are rejected before solving unless --no-validate is given.
+ *
+ * A run with the same seed, puzzle and sizes repeats exactly. When no seed is
+ * given, one is taken from the clock and printed, so that any run can be
+ * repeated later, e.g. under a profiler with --verify to confirm that it
+ * follows the recorded run.
+ *
+ * With --warm, the run starts from the population in a checkpoint of an
+ * earlier run, repaired to fit the puzzle on standard input, which may have
+ * gained clues since. A puzzle that has moved on only a little is then
+ * solved in a fraction of the generations.
+ *
+ * With --threads, breeding and scoring run on N threads as a pipeline. Such
+ * runs are not repeatable, so they cannot be checkpointed, replayed or warm
+ * started.
+ *
+ * With --islands, N processes each evolve a population of their own, and
+ * every G generations (20 by default) send their best Puzzle to the next.
+ * An island that crashes is lost without ending the run. These runs are not
+ * repeatable either, and cannot be combined with --threads.
+ *
+ * With --progress, the fitness of each new best Puzzle is printed as soon as
+ * it is found.
+ *
+ * --mutation, --survival and --children tune the search: the chance that a
+ * child's cell changes (0.05), the share of each generation kept (0.1) and
+ * the children bred per survivor (9). A resumed run keeps the tuning saved
+ * in its checkpoint.
+ *
+ * In a build with SUDOKU_PROFILE defined, the time spent at each profiled
+ * site is reported on standard error, and --trace writes a Chrome trace of
+ * every generation.
  */
 int main(int argc, char** argv)
 {
     Puzzle test;
-    Puzzle fit;
-    srand(time(NULL));
-
-    cin >> test;
-    GeneticAlgorithm tryit(test, atoi(argv[1]), atoi(argv[2]));
-    //GeneticAlgorithm tryit(test, POPSIZE, MAXGENS);
-    fit = tryit.evolve();
-    fit.display();
-    cout << "Fitness: " << fit.fitness() << endl;
+    SolveLimits limits;
+    SolveResult fit;
+    const char *status[] = { "solved", "generations exhausted", "timed out",
+                             "budget exhausted", "rejected", "cancelled" };
+    const char *checkpoint = NULL, *resume = NULL, *warm = NULL;
+    const char *replay = NULL;
+    const char *verify = NULL, *trace = NULL;
+    bool validate = true, progress = false;
+    int every = 100, positional = 0, threads = 0, islands = 0, migrate = 20;
+    char *args[3] = { NULL, NULL, NULL };
+    uint64_t seed = static_cast<uint64_t>(
+        SolveLimits::Clock::now().time_since_epoch().count());
+    ReplayLog log;
+    ProgressPrinter printer;
+    Tuning tuning;
+    bool tuned = false;
+
+    // Options may appear anywhere; everything else is positional.
+    for (int i = 1; i < argc; ++i)
+    {
+        const char *value;
+
+        if ((value = optionValue(argv[i], "--checkpoint=")) != NULL)
+        {
+            checkpoint = value;
+        }
+        else if ((value = optionValue(argv[i], "--every=")) != NULL)
+        {
+            if (!parseCount(value, 1, every))
+            {
+                cerr << "Invalid checkpoint interval: " << argv[i] << endl;
+                return (EXIT_FAILURE);
+            } // end if (!parseCount(value, 1, every))
+        }
+        else if ((value = optionValue(argv[i], "--resume=")) != NULL)
+        {
+            resume = value;
+        }
+        else if ((value = optionValue(argv[i], "--warm=")) != NULL)
+        {
+            warm = value;
+        }
+        else if ((value = optionValue(argv[i], "--seed=")) != NULL)
+        {
+            if (!parseSeed(value, seed))
+            {
+                cerr << "Invalid seed: " << argv[i] << endl;
+                return (EXIT_FAILURE);
+            } // end if (!parseSeed(value, seed))
+        }
+        else if ((value = optionValue(argv[i], "--replay=")) != NULL)
+        {
+            replay = value;
+        }
+        else if ((value = optionValue(argv[i], "--verify=")) != NULL)
+        {
+            verify = value;
+        }
+        else if (string(argv[i]) == "--no-validate")
+        {
+            validate = false;
+        }
+        else if (string(argv[i]) == "--progress")
+        {
+            progress = true;
+        }
+        else if ((value = optionValue(argv[i], "--trace=")) != NULL)
+        {
+            trace = value;
+        }
+        else if ((value = optionValue(argv[i], "--mutation=")) != NULL)
+        {
+            if (!parseFraction(value, tuning.mutantiness))
+            {
+                cerr << "Invalid mutation rate: " << argv[i] << endl;
+                return (EXIT_FAILURE);
+            } // end if (!parseFraction(value, tuning.mutantiness))
+
+            tuned = true;
+        }
+        else if ((value = optionValue(argv[i], "--survival=")) != NULL)
+        {
+            if (!parseFraction(value, tuning.survival))
+            {
+                cerr << "Invalid survival share: " << argv[i] << endl;
+                return (EXIT_FAILURE);
+            } // end if (!parseFraction(value, tuning.survival))
+
+            tuned = true;
+        }
+        else if ((value = optionValue(argv[i], "--children=")) != NULL)
+        {
+            if (!parseCount(value, 1, tuning.children))
+            {
+                cerr << "Invalid children per survivor: " << argv[i] << endl;
+                return (EXIT_FAILURE);
+            } // end if (!parseCount(value, 1, tuning.children))
+
+            tuned = true;
+        }
+        else if ((value = optionValue(argv[i], "--threads=")) != NULL)
+        {
+            if (!parseCount(value, 1, threads))
+            {
+                cerr << "Invalid thread count: " << argv[i] << endl;
+                return (EXIT_FAILURE);
+            } // end if (!parseCount(value, 1, threads))
+        }
+        else if ((value = optionValue(argv[i], "--islands=")) != NULL)
+        {
+            if (!parseCount(value, 1, islands))
+            {
+                cerr << "Invalid island count: " << argv[i] << endl;
+                return (EXIT_FAILURE);
+            } // end if (!parseCount(value, 1, islands))
+        }
+        else if ((value = optionValue(argv[i], "--migrate=")) != NULL)
+        {
+            if (!parseCount(value, 1, migrate))
+            {
+                cerr << "Invalid migration interval: " << argv[i] << endl;
+                return (EXIT_FAILURE);
+            } // end if (!parseCount(value, 1, migrate))
+        }
+        else if (positional < 3)
+        {
+            args[positional++] = argv[i];
+        } // end if ((value = optionValue(argv[i], "--checkpoint=")) != NULL)
+    } // end for (int i = 1; i < argc; ++i)
+
+    if (threads > 0 && (checkpoint != NULL || replay != NULL ||
+                        verify != NULL || warm != NULL))
+    {
+        cerr << "--threads cannot be combined with --checkpoint, --replay,"
+             << " --verify or --warm." << endl;
+        return (EXIT_FAILURE);
+    } // end if (threads > 0 && (checkpoint != NULL || ...))
+
+    if (islands > 0 && (threads > 0 || checkpoint != NULL ||
+                        replay != NULL || verify != NULL))
+    {
+        cerr << "--islands cannot be combined with --threads, --checkpoint,"
+             << " --replay or --verify." << endl;
+        return (EXIT_FAILURE);
+    } // end if (islands > 0 && (threads > 0 || ...))
+
+    if (resume != NULL && warm != NULL)
+    {
+        cerr << "--resume cannot be combined with --warm." << endl;
+        return (EXIT_FAILURE);
+    } // end if (resume != NULL && warm != NULL)
+
+    if (resume != NULL && tuned)
+    {
+        cerr << "--resume cannot be combined with --mutation, --survival"
+             << " or --children." << endl;
+        return (EXIT_FAILURE);
+    } // end if (resume != NULL && tuned)
+
+    if (trace != NULL && !Profiler::compiledIn())
+    {
+        cerr << "--trace needs a build with SUDOKU_PROFILE defined." << endl;
+        return (EXIT_FAILURE);
+    } // end if (trace != NULL && !Profiler::compiledIn())
+
+    if (trace != NULL && !Profiler::global().traceTo(trace))
+    {
+        cerr << "Cannot open trace file " << trace << endl;
+        return (EXIT_FAILURE);
+    } // end if (trace != NULL && !Profiler::global().traceTo(trace))
+
+    // An optional third argument bounds the run in wall-clock seconds.
+    if (args[2] != NULL)
+    {
+        double seconds;
+
+        if (!parseSeconds(args[2], seconds))
+        {
+            cerr << "Invalid time limit: " << args[2] << endl;
+            return (EXIT_FAILURE);
+        } // end if (!parseSeconds(args[2], seconds))
+
+        limits = SolveLimits::within(seconds);
+    } // end if (args[2] != NULL)
+
+    GeneticAlgorithm tryit;
+
+    if (resume != NULL)             // puzzle and sizes come from the file
+    {
+        if (!tryit.restore(resume))
+        {
+            cerr << "Cannot resume from " << resume << endl;
+            return (EXIT_FAILURE);
+        } // end if (!tryit.restore(resume))
+    }
+    else
+    {
+        int popSize, maxGens;
+
+        // Fewer than 10 Puzzles leaves no survivors to breed from.
+        if (!parseCount(args[0], 10, popSize) ||
+            !parseCount(args[1], 1, maxGens))
+        {
+            cerr << "Usage: " << argv[0] << " POPSIZE MAXGENS [SECONDS]"
+                 << " [--checkpoint=FILE] [--every=N] [--resume=FILE]"
+                 << " [--warm=FILE] [--seed=N] [--replay=FILE] [--verify=FILE]"
+                 << " [--no-validate] [--threads=N] [--trace=FILE]"
+                 << " [--progress] [--mutation=P] [--survival=F]"
+                 << " [--children=N] [--islands=N] [--migrate=G]" << endl
+                 << "  POPSIZE must be at least 10, MAXGENS at least 1."
+                 << endl;
+            return (EXIT_FAILURE);
+        } // end if (!parseCount(args[0], 10, popSize))
+
+        if (!(cin >> test))
+        {
+            cerr << "Expected 81 digits on standard input." << endl;
+            return (EXIT_FAILURE);
+        } // end if (!(cin >> test))
+
+        tryit = GeneticAlgorithm(test, popSize, maxGens);
+        //tryit = GeneticAlgorithm(test, POPSIZE, MAXGENS);
+        tryit.seed(seed);
+
+        if (!tryit.tune(tuning))
+        {
+            cerr << "--survival must keep at least one Puzzle and fewer than "
+                 << popSize << "." << endl;
+            return (EXIT_FAILURE);
+        } // end if (!tryit.tune(tuning))
+
+        if (warm != NULL && !tryit.warmStart(string(warm)))
+        {
+            cerr << "Cannot warm start from " << warm << endl;
+            return (EXIT_FAILURE);
+        } // end if (warm != NULL && !tryit.warmStart(string(warm)))
+    } // end if (resume != NULL)
+
+    // A resumed run carries its random state in the checkpoint, so its log
+    // is keyed on the checkpoint's puzzle with seed 0.
+    if (resume != NULL)
+    {
+        seed = 0;
+        test = Puzzle();
+    } // end if (resume != NULL)
+
+    if ((replay != NULL &&
+         !log.record(replay, seed, test, tryit.populationSize(),
+                     tryit.tuning())) ||
+        (verify != NULL &&
+         !log.verify(verify, seed, test, tryit.populationSize(),
+                     tryit.tuning())))
+    {
+        if (log.mismatch() != NULL)
+        {
+            cerr << "Replay log " << verify << " was recorded with another "
+                 << log.mismatch() << "." << endl;
+        }
+        else
+        {
+            cerr << "Cannot open replay log "
+                 << (replay != NULL ? replay : verify) << endl;
+        } // end if (log.mismatch() != NULL)
+
+        return (EXIT_FAILURE);
+    } // end if ((replay != NULL && !log.record(...)) || ...)
+
+    if (replay != NULL || verify != NULL)
+    {
+        tryit.replayTo(&log);
+    } // end if (replay != NULL || verify != NULL)
+
+    if (checkpoint != NULL)
+    {
+        tryit.checkpointTo(checkpoint, every);
+    } // end if (checkpoint != NULL)
+
+    if (progress)
+    {
+        tryit.reportTo(&printer);
+    } // end if (progress)
+
+    limits.validate = validate;
+
+    if (threads > 0)
+    {
+        Pipeline pipeline(tryit, threads);
+
+        fit = pipeline.run(limits);
+    }
+    else if (islands > 0)
+    {
+        Islands archipelago(tryit, islands, migrate);
+
+        fit = archipelago.run(limits);
+
+        if (archipelago.lost() > 0)
+        {
+            cerr << archipelago.lost() << " of " << islands
+                 << " islands were lost." << endl;
+        } // end if (archipelago.lost() > 0)
+    }
+    else
+    {
+        fit = tryit.evolve(limits);
+    } // end if (threads > 0)
+
+    if (Profiler::compiledIn())
+    {
+        Profiler::global().closeTrace();
+        Profiler::global().report(cerr);
+    } // end if (Profiler::compiledIn())
+
+    if (fit.status == REJECTED)
+    {
+        cerr << "Rejected: puzzle is "
+             << SolutionCounter::describe(fit.validity) << endl;
+        return (EXIT_FAILURE);
+    } // end if (fit.status == REJECTED)
+    fit.best.display();
+    cout << "Fitness: " << fit.best.fitness() << endl;
+    cout << "Status: " << status[fit.status] << " after " << fit.generations
+         << " generations" << endl;
+
+    if (fit.cutoffs.culled > 0)
+    {
+        long checks = fit.cutoffs.checksMade + fit.cutoffs.checksSkipped;
+
+        cout << "Culled early: " << fit.cutoffs.culled << " of "
+             << fit.cutoffs.scored << " children, skipping "
+             << 100 * fit.cutoffs.checksSkipped / checks << "% of checks"
+             << endl;
+    } // end if (fit.cutoffs.culled > 0)
+
+    if (resume == NULL)
+    {
+        cout << "Seed: " << seed << endl;
+    } // end if (resume == NULL)
+
+    // Closing the log checks that the recorded run ended here too.
+    log.close();
+
+    if (verify != NULL)
+    {
+        if (log.divergence() == 0)
+        {
+            cout << "Replay: matched" << endl;
+        }
+        else
+        {
+            cout << "Replay: diverged at generation " << log.divergence()
+                 << endl;
+        } // end if (log.divergence() == 0)
+    } // end if (verify != NULL)
 
     return (EXIT_SUCCESS);
 }
@@ -0,0 +1,114 @@
+/**
+ * @file    sudokud.cpp
+ * @brief   This program runs the solver as a local daemon, answering puzzles
+ *          sent over a Unix domain socket until it receives SIGINT or
+ *          SIGTERM. See SolverDaemon.h for the protocol.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#include <csignal>
+
+#include "Options.h"
+#include "SolverDaemon.h"
+
+using namespace std;
+
+static SolverDaemon *active = NULL;
+
+
+/** Stop the daemon when asked to terminate.
+ * @param signal  The signal received.
+ * @pre None.
+ * @post The daemon has been asked to stop.
+ */
+static void onSignal(int /* signal */)
+{
+    if (active != NULL)
+    {
+        active->stop();
+    } // end if (active != NULL)
+} // end onSignal(int)
+
+
+/*
+ * Usage: sudokud [--socket=PATH] [--workers=N] [--batch=N] [--queue=N]
+ *                [--pop=N] [--gens=N] [--seconds=S] [--seed=N]
+ *                [--no-validate]
+ */
+int main(int argc, char** argv)
+{
+    DaemonSettings settings;
+    int queueLimit = settings.queueLimit;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char *value;
+        bool good = false;
+
+        if ((value = optionValue(argv[i], "--socket=")) != NULL)
+        {
+            settings.socketPath = value;
+            good = true;
+        }
+        else if ((value = optionValue(argv[i], "--workers=")) != NULL)
+        {
+            good = parseCount(value, 1, settings.workers);
+        }
+        else if ((value = optionValue(argv[i], "--batch=")) != NULL)
+        {
+            good = parseCount(value, 1, settings.batchSize);
+        }
+        else if ((value = optionValue(argv[i], "--queue=")) != NULL)
+        {
+            good = parseCount(value, 1, queueLimit);
+        }
+        else if ((value = optionValue(argv[i], "--pop=")) != NULL)
+        {
+            good = parseCount(value, 10, settings.popSize);
+        }
+        else if ((value = optionValue(argv[i], "--gens=")) != NULL)
+        {
+            good = parseCount(value, 1, settings.maxGens);
+        }
+        else if ((value = optionValue(argv[i], "--seconds=")) != NULL)
+        {
+            good = parseSeconds(value, settings.seconds);
+        }
+        else if ((value = optionValue(argv[i], "--seed=")) != NULL)
+        {
+            good = parseSeed(value, settings.seed);
+        }
+        else if (string(argv[i]) == "--no-validate")
+        {
+            settings.validate = false;
+            good = true;
+        } // end if ((value = optionValue(argv[i], "--socket=")) != NULL)
+
+        if (!good)
+        {
+            cerr << "Invalid argument: " << argv[i] << endl
+                 << "Usage: " << argv[0] << " [--socket=PATH] [--workers=N]"
+                 << " [--batch=N] [--queue=N] [--pop=N] [--gens=N]"
+                 << " [--seconds=S] [--seed=N] [--no-validate]" << endl;
+            return (EXIT_FAILURE);
+        } // end if (!good)
+    } // end for (int i = 1; i < argc; ++i)
+
+    settings.queueLimit = queueLimit;
+    SolverDaemon server(settings);
+    active = &server;
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    if (!server.run())
+    {
+        cerr << "Cannot listen on " << settings.socketPath << endl;
+        return (EXIT_FAILURE);
+    } // end if (!server.run())
+
+    cerr << "Served " << server.served() << ", refused " << server.refused()
+         << endl;
+
+    return (EXIT_SUCCESS);
+}
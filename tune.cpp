@@ -0,0 +1,357 @@
+/**
+ * @file    tune.cpp
+ * @brief   This program searches for the population size and Tuning that
+ *          solve a corpus of puzzles fastest, separately for each difficulty
+ *          tier. Random configurations race by successive halving: every
+ *          configuration still in the race solves the same few puzzles with
+ *          the same seeds, the slower half by median time-to-solution drops
+ *          out, and the rest go on to twice as many puzzles. The runs of each
+ *          round are shared out on a work-stealing pool. The winner of each
+ *          tier is reported beside the default configuration, which always
+ *          enters the race and is measured on the winner's puzzles if it
+ *          drops out.
+ * @author  agent
+ * @date    October 18, 2026
+ */
+
+#include <algorithm>
+#include <cstdio>
+
+#include "Corpus.h"
+#include "GeneticAlgorithm.h"
+#include "Options.h"
+#include "PuzzleGenerator.h"
+#include "WorkStealingPool.h"
+
+using namespace std;
+
+
+/** A configuration in the race, with its times so far.
+ */
+struct Candidate
+{
+    int popSize;
+    Tuning tuning;
+    vector<double> millis;  // per puzzle; unsolved runs are charged double
+};
+
+
+/** One puzzle solved by one configuration, timed.
+ */
+class Run : public Task
+{
+public:
+
+    /** Constructor.
+     * @param puzzle  The puzzle to solve.
+     * @param entrant  The configuration to solve it with.
+     * @param maxGens  Maximum number of generations before giving up.
+     * @param seconds  Time allowed; a run that needs more is charged double.
+     * @param seed  Seeds the run; every configuration uses the same one.
+     * @param millis  Where to leave the time charged.
+     */
+    Run(const Puzzle& puzzle, const Candidate& entrant, int maxGens,
+        double seconds, uint64_t seed, double& millis) :
+        puzzle(puzzle), entrant(entrant), maxGens(maxGens), seconds(seconds),
+        seed(seed), millis(millis)
+    {
+    } // end constructor
+
+    /** Solve the puzzle and record the time charged.
+     * @param worker  The index of the worker running the task.
+     * @pre None.
+     * @post millis holds the time taken, or twice the limit if the puzzle
+     *       was not solved.
+     * @return false; the run is done in one call.
+     */
+    virtual bool run(int /* worker */)
+    {
+        GeneticAlgorithm engine(puzzle, entrant.popSize, maxGens);
+        SolveLimits::Clock::time_point start = SolveLimits::Clock::now();
+
+        engine.seed(seed);
+        engine.tune(entrant.tuning);
+
+        SolveResult result = engine.evolve(SolveLimits::within(seconds));
+
+        millis = result.status == SOLVED ?
+                 chrono::duration<double, milli>(
+                     SolveLimits::Clock::now() - start).count() :
+                 2000.0 * seconds;
+
+        return false;
+    } // end run(int)
+
+private:
+
+    const Puzzle& puzzle;
+    const Candidate& entrant;
+    int maxGens;
+    double seconds;
+    uint64_t seed;
+    double& millis;
+
+    // Not copyable; a Run refers to its result.
+    Run(const Run& orig);
+    void operator=(const Run& rhs);
+
+};
+
+
+/** Find the median time of a configuration over its first puzzles.
+ * @param entrant  The configuration.
+ * @param count  The number of puzzles to count, at least 1.
+ * @pre entrant has been timed on at least count puzzles.
+ * @post None.
+ * @return The median time charged, in milliseconds; for an even count, the
+ *         mean of the two middle times.
+ */
+static double median(const Candidate& entrant, size_t count)
+{
+    vector<double> times(entrant.millis.begin(),
+                         entrant.millis.begin() + count);
+
+    nth_element(times.begin(), times.begin() + count / 2, times.end());
+
+    double middle = times[count / 2];
+
+    // Everything before the upper middle is no greater; the greatest of it
+    // is the lower middle.
+    if (count % 2 == 0)
+    {
+        middle = (middle + *max_element(times.begin(),
+                                        times.begin() + count / 2)) / 2.0;
+    } // end if (count % 2 == 0)
+
+    return middle;
+} // end median(Candidate&, size_t)
+
+/** Orders configurations by median time over the puzzles of a round.
+ */
+struct ByMedian
+{
+    size_t count;
+
+    bool operator()(const Candidate *lhs, const Candidate *rhs) const
+    {
+        return median(*lhs, count) < median(*rhs, count);
+    } // end operator()(Candidate*, Candidate*)
+};
+
+
+/** Time configurations on the first puzzles of a tier, skipping the
+ *  puzzles each has already been timed on.
+ * @param entrants  The configurations.
+ * @param puzzles  The puzzles of the tier.
+ * @param count  The number of puzzles each must be timed on.
+ * @param seeds  One seed per puzzle.
+ * @param maxGens  Maximum number of generations before giving up.
+ * @param seconds  Time allowed each run.
+ * @param pool  The workers to run on.
+ * @pre count is no more than puzzles.size() or seeds.size().
+ * @post Every configuration has been timed on count puzzles.
+ */
+static void measure(const vector<Candidate*>& entrants,
+                    const vector<Puzzle>& puzzles, size_t count,
+                    const vector<uint64_t>& seeds, int maxGens,
+                    double seconds, WorkStealingPool& pool)
+{
+    vector<Task*> runs;
+
+    for (size_t i = 0; i < entrants.size(); ++i)
+    {
+        size_t done = entrants[i]->millis.size();
+
+        entrants[i]->millis.resize(max(done, count));
+
+        for (size_t p = done; p < count; ++p)
+        {
+            runs.push_back(new Run(puzzles[p], *entrants[i], maxGens,
+                                   seconds, seeds[p],
+                                   entrants[i]->millis[p]));
+        } // end for (size_t p = done; p < count; ++p)
+    } // end for (size_t i = 0; i < entrants.size(); ++i)
+
+    pool.runAll(runs);
+
+    for (size_t i = 0; i < runs.size(); ++i)
+    {
+        delete runs[i];
+    } // end for (size_t i = 0; i < runs.size(); ++i)
+} // end measure(vector<Candidate*>&, vector<Puzzle>&, size_t, ...)
+
+/** Draw a random configuration, usable and not so large that a generation
+ *  grows past ten times the population.
+ * @param draw  The source of randomness.
+ * @param entrant  Set to the configuration.
+ * @pre None.
+ * @post None.
+ */
+static void randomize(Random& draw, Candidate& entrant)
+{
+    static const int SIZES[] = { 100, 150, 200, 300, 400, 500, 750, 1000,
+                                 1500, 2000 };
+
+    do
+    {
+        entrant.popSize = SIZES[draw.below(sizeof(SIZES) / sizeof(int))];
+        entrant.tuning.mutantiness = 0.01 + 0.19 * draw.uniform();
+        entrant.tuning.survival = 0.02 + 0.28 * draw.uniform();
+        entrant.tuning.children = 1 + draw.below(20);
+    } while (!entrant.tuning.usable(entrant.popSize) ||
+             entrant.tuning.survivors(entrant.popSize) *
+             (1 + entrant.tuning.children) > 10 * entrant.popSize);
+} // end randomize(Random&, Candidate&)
+
+/** Race configurations on the puzzles of one tier and report the winner.
+ * @param tier  The tier.
+ * @param puzzles  Its puzzles.
+ * @param configs  The number of configurations to race, default included.
+ * @param start  The puzzles each configuration solves in the first round.
+ * @param maxGens  Maximum number of generations before giving up.
+ * @param seconds  Time allowed each run.
+ * @param seed  Seeds the configurations and the runs.
+ * @param pool  The workers to run on.
+ * @pre puzzles is not empty.
+ * @post A line has been written to standard output.
+ */
+static void race(Difficulty tier, const vector<Puzzle>& puzzles, int configs,
+                 int start, int maxGens, double seconds, uint64_t seed,
+                 WorkStealingPool& pool)
+{
+    Random draw(seed + tier);
+    vector<Candidate> field(configs);
+    vector<Candidate*> left;
+    vector<uint64_t> seeds;
+    size_t count = min(static_cast<size_t>(start), puzzles.size());
+
+    field[0].popSize = 750;                 // the default stays as it is
+
+    for (size_t i = 1; i < field.size(); ++i)
+    {
+        randomize(draw, field[i]);
+    } // end for (size_t i = 1; i < field.size(); ++i)
+
+    for (size_t i = 0; i < field.size(); ++i)
+    {
+        left.push_back(&field[i]);
+    } // end for (size_t i = 0; i < field.size(); ++i)
+
+    for (size_t i = 0; i < puzzles.size(); ++i)
+    {
+        seeds.push_back(draw.next());
+    } // end for (size_t i = 0; i < puzzles.size(); ++i)
+
+    // Halve the field each round, and double the puzzles each survivor
+    // solves, until one is left.
+    while (true)
+    {
+        ByMedian byMedian = { count };
+
+        measure(left, puzzles, count, seeds, maxGens, seconds, pool);
+        stable_sort(left.begin(), left.end(), byMedian);
+
+        if (left.size() == 1)
+        {
+            break;
+        } // end if (left.size() == 1)
+
+        left.resize((left.size() + 1) / 2);
+        count = min(count * 2, puzzles.size());
+    } // end while (true)
+
+    // The default is timed on the winner's puzzles, if it has not been.
+    vector<Candidate*> baseline(1, &field[0]);
+
+    measure(baseline, puzzles, count, seeds, maxGens, seconds, pool);
+
+    const Candidate& best = *left[0];
+    double won = median(best, count), usual = median(field[0], count);
+
+    printf("%-8s %8zu %6d %9.3f %9.3f %9d %12.2f %12.2f %8.2f\n",
+           PuzzleGenerator::name(tier), count, best.popSize,
+           best.tuning.mutantiness, best.tuning.survival,
+           best.tuning.children, won, usual, usual / won);
+} // end race(Difficulty, vector<Puzzle>&, int, int, int, double, ...)
+
+
+/*
+ * Usage: tune [--configs=N] [--start=N] [--gens=N] [--seconds=S]
+ *             [--threads=N] [--seed=N] FILE...
+ *
+ * Runs share the machine, so timings are fairest with no more threads than
+ * cores.
+ */
+int main(int argc, char** argv)
+{
+    int configs = 16, start = 2, maxGens = 30000, threads = 1;
+    double seconds = 10.0;
+    uint64_t seed = 1;
+    vector<Puzzle> corpus, tiers[TIERS];
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char *value;
+        bool good;
+
+        if ((value = optionValue(argv[i], "--configs=")) != NULL)
+        {
+            good = parseCount(value, 1, configs);
+        }
+        else if ((value = optionValue(argv[i], "--start=")) != NULL)
+        {
+            good = parseCount(value, 1, start);
+        }
+        else if ((value = optionValue(argv[i], "--gens=")) != NULL)
+        {
+            good = parseCount(value, 1, maxGens);
+        }
+        else if ((value = optionValue(argv[i], "--seconds=")) != NULL)
+        {
+            good = parseSeconds(value, seconds);
+        }
+        else if ((value = optionValue(argv[i], "--threads=")) != NULL)
+        {
+            good = parseCount(value, 1, threads);
+        }
+        else if ((value = optionValue(argv[i], "--seed=")) != NULL)
+        {
+            good = parseSeed(value, seed);
+        }
+        else
+        {
+            good = readCorpus(argv[i], corpus);
+        } // end if ((value = optionValue(argv[i], "--configs=")) != NULL)
+
+        if (!good)
+        {
+            cerr << "Invalid argument: " << argv[i] << endl
+                 << "Usage: " << argv[0] << " [--configs=N] [--start=N]"
+                 << " [--gens=N] [--seconds=S] [--threads=N] [--seed=N]"
+                 << " FILE..." << endl;
+            return (EXIT_FAILURE);
+        } // end if (!good)
+    } // end for (int i = 1; i < argc; ++i)
+
+    for (size_t i = 0; i < corpus.size(); ++i)
+    {
+        tiers[PuzzleGenerator::grade(corpus[i])].push_back(corpus[i]);
+    } // end for (size_t i = 0; i < corpus.size(); ++i)
+
+    WorkStealingPool pool(threads);
+
+    printf("%-8s %8s %6s %9s %9s %9s %12s %12s %8s\n", "tier", "puzzles",
+           "pop", "mutation", "survival", "children", "median ms",
+           "default ms", "speedup");
+
+    for (int tier = 0; tier < TIERS; ++tier)
+    {
+        if (!tiers[tier].empty())
+        {
+            race(static_cast<Difficulty>(tier), tiers[tier], configs, start,
+                 maxGens, seconds, seed, pool);
+        } // end if (!tiers[tier].empty())
+    } // end for (int tier = 0; tier < TIERS; ++tier)
+
+    return (EXIT_SUCCESS);
+}